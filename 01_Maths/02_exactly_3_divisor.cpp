@@ -11,6 +11,10 @@ class Solution{
     bool isPrime(int n)
     {
         int i;
+        if(n<2)
+        {
+            return false;
+        }
         for(i=2;i<=sqrt(n);i++)
         {
             if(n%i==0)
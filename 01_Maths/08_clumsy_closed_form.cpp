@@ -0,0 +1,194 @@
+//https://leetcode.com/problems/clumsy-factorial/
+// O(1) version of 01_clumsy factorial.cpp.
+//
+// Every full group after the first is -k*(k-1)/(k-2) + (k-3). For k >= 5,
+// k*(k-1)/(k-2) == k+1 exactly, so the groups cancel pairwise and only the
+// first group and the tail of 1..4 leftover terms survive:
+//   n % 4 == 0 -> n + 1
+//   n % 4 == 1 -> n + 2
+//   n % 4 == 2 -> n + 2
+//   n % 4 == 3 -> n - 1
+// for n > 4; n <= 4 is computed with the loop. The loop below uses 128-bit
+// intermediates so it is exact for any 64-bit n (the original int version
+// overflows in temp*=n once n*(n-1) > 2^31).
+//
+// Build: g++ -O2 -mavx2 08_clumsy_closed_form.cpp   (without -mavx2 the batch
+// entry point runs its scalar loop)
+#include <iostream>
+#include <cstdint>
+#include <vector>
+#include <chrono>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+typedef __int128 i128;
+
+class Solution {
+public:
+    // The original from 01_clumsy factorial.cpp; int, so exact for n <= 46341.
+    int clumsy(int n) {
+        int    result=0,temp=0,op=-1;
+        temp=n;
+        n-- ;op++;
+        while(n>0){
+            if(op ==0){
+                temp*=n;
+            }
+            if(op ==1){
+                temp/=n;
+            }
+            if(op ==2){
+                temp+=n;}
+             if(op ==3){   
+                op  =-1;
+                result+=temp;
+                temp = -n;
+            }
+            op++  ;
+            n--;
+        }
+        return temp+result;
+    }
+
+    // The same algorithm in 128-bit arithmetic, exact for small n.
+    i128 clumsyLoop(int64_t n) {
+        i128 result = 0, temp = n;
+        int op = 0;
+        for (i128 k = n - 1; k > 0; k--) {
+            if (op == 0)
+                temp *= k;
+            else if (op == 1)
+                temp /= k;
+            else if (op == 2)
+                temp += k;
+            else {
+                result += temp;
+                temp = -k;
+                op = -1;
+            }
+            op++;
+        }
+        return temp + result;
+    }
+
+    // 64-bit result; sets overflow (and returns 0) if it does not fit.
+    int64_t clumsy64(int64_t n, bool& overflow) {
+        overflow = false;
+        if (n <= 4)
+            return (int64_t)clumsyLoop(n);
+        int64_t r;
+        overflow = __builtin_add_overflow(n, offset(n), &r);
+        return overflow ? 0 : r;
+    }
+
+    // 128-bit argument and result. Only n close to 2^127 can overflow.
+    i128 clumsy128(i128 n, bool& overflow) {
+        overflow = false;
+        if (n <= 4)
+            return clumsyLoop((int64_t)n);
+        i128 r;
+        overflow = __builtin_add_overflow(n, (i128)offset((int64_t)(n & 3)), &r);
+        return overflow ? 0 : r;
+    }
+
+    // Batch entry point: out[i] = clumsy(ns[i]). Inputs must be in 1..INT64_MAX-2
+    // (the results then always fit). Both paths compute n + offset + fix, where
+    // fix corrects n <= 4 (1, 2, 6, 7 instead of 3, 4, 2, 5) with compare masks
+    // instead of a table; with -mavx2 four values go per step.
+    void clumsyBatch(const int64_t* ns, int64_t* out, size_t count) {
+        size_t i = 0;
+#ifdef __AVX2__
+        const __m256i three = _mm256_set1_epi64x(3), four = _mm256_set1_epi64x(4);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 4 <= count; i += 4) {
+            __m256i n = _mm256_loadu_si256((const __m256i*)(ns + i));
+            __m256i r = _mm256_and_si256(n, three);
+            // offset = 2, minus 1 where r == 0, minus 3 where r == 3
+            __m256i off = _mm256_add_epi64(_mm256_set1_epi64x(2),
+                _mm256_and_si256(_mm256_cmpeq_epi64(r, zero), _mm256_set1_epi64x(-1)));
+            off = _mm256_add_epi64(off,
+                _mm256_and_si256(_mm256_cmpeq_epi64(r, three), _mm256_set1_epi64x(-3)));
+            // fix = -2 for n <= 2, +4 for n == 3, +2 for n == 4
+            __m256i fix = _mm256_and_si256(_mm256_cmpgt_epi64(three, n), _mm256_set1_epi64x(-2));
+            fix = _mm256_or_si256(fix, _mm256_and_si256(_mm256_cmpeq_epi64(n, three), four));
+            fix = _mm256_or_si256(fix, _mm256_and_si256(_mm256_cmpeq_epi64(n, four), _mm256_set1_epi64x(2)));
+            _mm256_storeu_si256((__m256i*)(out + i), _mm256_add_epi64(n, _mm256_add_epi64(off, fix)));
+        }
+#endif
+        for (; i < count; i++) {
+            int64_t n = ns[i];
+            int64_t r = n & 3;
+            int64_t off = r == 0 ? 1 : r == 3 ? -1 : 2;
+            int64_t fix = n <= 2 ? -2 : n == 3 ? 4 : n == 4 ? 2 : 0;
+            out[i] = n + off + fix;
+        }
+    }
+
+private:
+    static int64_t offset(int64_t n) {
+        static const int64_t add[4] = {1, 2, 2, -1};
+        return add[n & 3];
+    }
+};
+
+static void print128(i128 v) {
+    if (v < 0) {
+        cout << '-';
+        v = -v;
+    }
+    char buf[48];
+    int len = 0;
+    do {
+        buf[len++] = (char)('0' + (int)(v % 10));
+        v /= 10;
+    } while (v > 0);
+    while (len > 0)
+        cout << buf[--len];
+}
+
+int main() {
+    Solution ob;
+
+    // Property check: closed form and batch == the original int clumsy() over
+    // its whole exact range (n*(n-1) must fit in an int).
+    const int64_t LIMIT = 46341;
+    vector<int64_t> small(LIMIT), small_out(LIMIT);
+    for (int64_t n = 1; n <= LIMIT; n++)
+        small[n - 1] = n;
+    ob.clumsyBatch(small.data(), small_out.data(), LIMIT);
+    int64_t mismatches = 0;
+    bool of;
+    for (int64_t n = 1; n <= LIMIT; n++) {
+        int64_t want = ob.clumsy((int)n);
+        if (ob.clumsy64(n, of) != want || of || small_out[n - 1] != want)
+            mismatches++;
+    }
+    cout << "closed form and batch vs original for n = 1.." << LIMIT << ": " << mismatches << " mismatches" << endl;
+
+    int64_t r = ob.clumsy64(INT64_MAX, of);
+    cout << "clumsy64(INT64_MAX): " << (of ? "overflow" : to_string(r)) << endl;
+    r = ob.clumsy64(INT64_MAX - 1, of);
+    cout << "clumsy64(INT64_MAX - 1): " << (of ? "overflow" : to_string(r)) << endl;
+    i128 big = (i128)1 << 100;
+    cout << "clumsy128(2^100): ";
+    print128(ob.clumsy128(big, of));
+    cout << endl;
+
+    // Batch throughput.
+    const size_t count = 1 << 24;
+    vector<int64_t> ns(count), out(count);
+    for (size_t i = 0; i < count; i++)
+        ns[i] = (int64_t)(i * 2654435761u % 1000000000u) + 1;
+    auto t0 = chrono::steady_clock::now();
+    ob.clumsyBatch(ns.data(), out.data(), count);
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    int64_t bad = 0;
+    for (size_t i = 0; i < count; i++)
+        if (out[i] != ob.clumsy64(ns[i], of))
+            bad++;
+    cout << "batch of " << count << ": " << secs << " s, " << count / secs / 1e6
+         << " M/s, " << bad << " mismatches" << endl;
+    return 0;
+}
@@ -0,0 +1,182 @@
+// https://geeksforgeeks.org/batch/dsa-4/track/DSASP-Mathematics/problem/exactly-3-divisors
+// Same problem as 02_exactly_3_divisor.cpp, answered in O(1) per query.
+//
+// A number has exactly 3 divisors iff it is p*p for a prime p, so the answer
+// for N is pi(floor(sqrt(N))), the number of primes <= sqrt(N).
+// Instead of trial-dividing every i <= sqrt(N) per query, we read all the
+// queries, sieve once up to the largest sqrt(N) and keep a prime-count table:
+//
+//  - odd-only bit packing: bit i stands for 2i+1, so 1 bit per odd number
+//  - wheel pre-sieve: multiples of 3, 5, 7, 11, 13 are stamped into each
+//    segment from a precomputed pattern instead of being crossed off
+//  - segmented: 32 KB of bits at a time, so the crossing-off stays in L1
+//  - multi-threaded: segments are shared out between hardware threads
+//  - count table: one running count per 64-bit word, so
+//    pi(x) = 1 + counts[w] + popcount(bits[w] & low bits)  in O(1)
+#include <bits/stdc++.h>
+using namespace std;
+
+// } Driver Code Ends
+//User function Template for C++
+
+class PrimeCounter {
+    vector<uint64_t> bits;      // bit i of the array set <=> 2i+1 is prime
+    vector<uint32_t> counts;    // counts[w] = odd primes in words [0, w)
+
+    static const int SEGMENT_WORDS = 4096;                      // 32 KB
+    static const int PATTERN_PRIMES[5];
+    static const int PATTERN_WORDS = 3 * 5 * 7 * 11 * 13;       // period in words
+
+public:
+    // Sieves [0, n]. Safe to call once; n up to a few 1e9.
+    void build(uint64_t n, unsigned threads = thread::hardware_concurrency())
+    {
+        if (n < 2)
+            n = 2;
+        uint64_t odd_count = n / 2 + 1;               // bits for 1, 3, ..., <= n (+1 spare)
+        size_t words = (size_t)((odd_count + 63) / 64);
+        bits.assign(words, 0);
+        counts.assign(words + 1, 0);
+
+        // base primes up to sqrt(n) with a plain sieve
+        uint64_t root = isqrt(n);
+        vector<char> small(root + 1, 1);
+        vector<uint32_t> base;
+        for (uint64_t i = 2; i <= root; i++) {
+            if (!small[i])
+                continue;
+            if (i > 13)
+                base.push_back((uint32_t)i);
+            for (uint64_t j = i * i; j <= root; j += i)
+                small[j] = 0;
+        }
+
+        // wheel pattern: multiples of 3..13 cleared, period PATTERN_WORDS words
+        vector<uint64_t> pattern(PATTERN_WORDS, ~0ull);
+        for (int p : PATTERN_PRIMES)
+            for (uint64_t i = p / 2; i < (uint64_t)PATTERN_WORDS * 64; i += p)
+                pattern[i / 64] &= ~(1ull << (i % 64));
+
+        size_t segments = (words + SEGMENT_WORDS - 1) / SEGMENT_WORDS;
+        if (threads == 0)
+            threads = 1;
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                for (size_t s = t; s < segments; s += threads)
+                    sieve_segment(s, words, pattern, base);
+            });
+        }
+        for (auto &th : pool)
+            th.join();
+
+        // fix up the start: 1 is not prime, 3..13 were removed by the pattern
+        bits[0] &= ~1ull;
+        for (int p : PATTERN_PRIMES)
+            if ((uint64_t)p <= n)
+                bits[0] |= 1ull << (p / 2);
+        // drop bits past n
+        uint64_t last = (n - 1) / 2;                  // index of the largest odd <= n
+        if (last % 64 != 63)
+            bits[last / 64] &= (2ull << (last % 64)) - 1;
+        for (size_t w = last / 64 + 1; w < words; w++)
+            bits[w] = 0;
+
+        for (size_t w = 0; w < words; w++)
+            counts[w + 1] = counts[w] + (uint32_t)__builtin_popcountll(bits[w]);
+    }
+
+    // Number of primes <= x, for x <= the built limit.
+    uint64_t pi(uint64_t x) const
+    {
+        if (x < 2)
+            return 0;
+        uint64_t i = (x - 1) / 2;                     // last odd index <= x
+        size_t w = (size_t)(i / 64);
+        uint64_t mask = (i % 64 == 63) ? ~0ull : (2ull << (i % 64)) - 1;
+        return 1 + counts[w] + (uint64_t)__builtin_popcountll(bits[w] & mask);
+    }
+
+    static uint64_t isqrt(uint64_t n)
+    {
+        uint64_t r = (uint64_t)sqrtl((long double)n);
+        while (r * r > n)
+            r--;
+        while ((r + 1) * (r + 1) <= n)
+            r++;
+        return r;
+    }
+
+private:
+    void sieve_segment(size_t seg, size_t words, const vector<uint64_t> &pattern,
+                       const vector<uint32_t> &base)
+    {
+        size_t w0 = seg * SEGMENT_WORDS;
+        size_t w1 = min(words, w0 + SEGMENT_WORDS);
+        for (size_t w = w0; w < w1; w++)
+            bits[w] = pattern[w % PATTERN_WORDS];
+
+        uint64_t lo = (uint64_t)w0 * 64;              // first bit index
+        uint64_t hi = (uint64_t)w1 * 64;              // one past the last
+        for (uint32_t p : base) {
+            // first odd multiple of p that is >= max(p*p, 2*lo+1), as a bit index
+            uint64_t start = (uint64_t)p * p;
+            uint64_t first_num = 2 * lo + 1;
+            if (start < first_num) {
+                start = (first_num + p - 1) / p * p;
+                if (start % 2 == 0)
+                    start += p;
+            }
+            uint64_t i = start / 2;
+            if (i >= hi)
+                continue;
+            for (; i < hi; i += p)
+                bits[i / 64] &= ~(1ull << (i % 64));
+        }
+    }
+};
+
+const int PrimeCounter::PATTERN_PRIMES[5] = {3, 5, 7, 11, 13};
+
+class Solution{
+    public:
+    const PrimeCounter *table;
+
+    int exactly3Divisors(long long N)
+    {
+        if (N < 4)
+            return 0;
+        return (int)table->pi(PrimeCounter::isqrt((uint64_t)N));
+    }
+};
+
+//{ Driver Code Starts.
+
+
+int main()
+ {
+    int T;
+
+    //taking testcases
+    cin>>T;
+    vector<long long> queries(T);
+    long long largest = 0;
+    for(int i=0;i<T;i++)
+    {
+        //taking N
+        cin>>queries[i];
+        largest = max(largest, queries[i]);
+    }
+
+    //one sieve up to sqrt of the largest N, then O(1) per query
+    PrimeCounter pc;
+    pc.build(PrimeCounter::isqrt((uint64_t)max(largest, 0LL)));
+    Solution ob;
+    ob.table = &pc;
+    for(int i=0;i<T;i++)
+    {
+        //calling function exactly3Divisors()
+        cout<<ob.exactly3Divisors(queries[i])<<"\n";
+    }
+	return 0;
+}
@@ -0,0 +1,286 @@
+// Prime counting pi(x) with Lehmer's formula, for exactly3Divisors at large N.
+//
+// exactly3Divisors(N) = pi(floor(sqrt(N))) (see 02_exactly_3_divisor.cpp). For
+// N up to 1e18 that is pi(x) with x up to 1e9, which Lehmer's method computes
+// without sieving all the way to x:
+//
+//   a = pi(x^(1/4)), b = pi(x^(1/2)), c = pi(x^(1/3))
+//   pi(x) = phi(x, a) + (b + a - 2)(b - a + 1)/2
+//           - sum_{a<i<=b} pi(x / p_i)
+//           - sum_{a<i<=c} sum_{i<=j<=b_i} (pi(x / (p_i p_j)) - (j - 1)),
+//   b_i = pi(sqrt(x / p_i))
+//
+// phi(x, a) counts n <= x with no prime factor among the first a primes:
+//   phi(x, a) = phi(x, a-1) - phi(x / p_a, a-1)
+// It is evaluated with
+//   - a closed form for a <= 6 using the period 2*3*5*7*11*13 = 30030,
+//   - a shortcut phi(x, a) = pi(x) - a + 1 once p_a^2 > x (table lookup),
+//   - a memo table for small (x, a) pairs reused across the whole computation.
+// pi(y) for y up to about x^(2/3) comes from a table built by a multi-threaded
+// segmented sieve; larger y recurse into Lehmer again (memoised).
+//
+// main() benchmarks Lehmer against a plain segmented sieve count for
+// x = 1e6, 1e7, ... up to max_x; the sieve is only run up to sieve_max.
+//      Usage: ./a.out [max_x] [sieve_max]
+#include <bits/stdc++.h>
+using namespace std;
+
+static uint64_t isqrt(uint64_t n)
+{
+    uint64_t r = (uint64_t)sqrtl((long double)n);
+    while (r > 0 && r * r > n)
+        r--;
+    while ((r + 1) <= UINT32_MAX && (r + 1) * (r + 1) <= n)
+        r++;
+    return r;
+}
+
+// Largest r with r^k <= n (k = 3 or 4), exact.
+static uint64_t iroot(uint64_t n, int k)
+{
+    uint64_t r = (uint64_t)powl((long double)n, 1.0L / k);
+    auto pow_le = [&](uint64_t v) {
+        unsigned __int128 p = 1;
+        for (int i = 0; i < k; i++)
+            p *= v;
+        return p <= n;
+    };
+    while (r > 0 && !pow_le(r))
+        r--;
+    while (pow_le(r + 1))
+        r++;
+    return r;
+}
+
+class LehmerPi {
+    vector<uint32_t> primes;            // primes up to the table limit
+    vector<uint32_t> pi_table;          // pi_table[y] = pi(y) for y <= limit
+    uint64_t limit = 0;
+    unordered_map<uint64_t, uint64_t> big_cache;
+
+    // phi for a <= 6: period Q = p1*...*pa, phi(x, a) = (x / Q) phi(Q, a) + phi(x % Q, a)
+    static const int SMALL_A = 6;
+    uint32_t small_q[SMALL_A + 1];
+    vector<vector<uint16_t>> small_phi;  // small_phi[a][r] = phi(r, a) for r < Q_a
+
+    // memo for phi(x, a) with x < MEMO_X, a < MEMO_A
+    static const uint32_t MEMO_X = 1 << 16;
+    static const uint32_t MEMO_A = 100;
+    vector<int32_t> memo;
+
+public:
+    // Builds the pi table up to max(table_limit, 100) with `threads` sieving threads.
+    explicit LehmerPi(uint64_t table_limit, unsigned threads = thread::hardware_concurrency())
+    {
+        limit = max<uint64_t>(table_limit, 100);
+        sieve_table(threads == 0 ? 1 : threads);
+        build_small_phi();
+        memo.assign((size_t)MEMO_X * MEMO_A, -1);
+    }
+
+    // Suggested table size for queries up to x: about x^(2/3), capped at 2e8.
+    static uint64_t table_size_for(uint64_t x)
+    {
+        uint64_t t = (uint64_t)powl((long double)x, 2.0L / 3);
+        return min<uint64_t>(max<uint64_t>(t, 1000), 200000000);
+    }
+
+    // Requires x <= table_limit()^2, so that every p_i <= sqrt(x) is in the table.
+    uint64_t pi(uint64_t x)
+    {
+        if (x <= limit)
+            return pi_table[x];
+        auto it = big_cache.find(x);
+        if (it != big_cache.end())
+            return it->second;
+
+        uint64_t a = pi(iroot(x, 4));
+        uint64_t b = pi(isqrt(x));
+        uint64_t c = pi(iroot(x, 3));
+        int64_t sum = (int64_t)phi(x, a) + (int64_t)((b + a - 2) * (b - a + 1) / 2);
+        for (uint64_t i = a + 1; i <= b; i++) {
+            uint64_t w = x / prime(i);
+            sum -= (int64_t)pi(w);
+            if (i <= c) {
+                uint64_t bi = pi(isqrt(w));
+                for (uint64_t j = i; j <= bi; j++)
+                    sum -= (int64_t)pi(w / prime(j)) - (int64_t)(j - 1);
+            }
+        }
+        big_cache[x] = (uint64_t)sum;
+        return (uint64_t)sum;
+    }
+
+    uint64_t table_limit() const { return limit; }
+
+private:
+    // 1-based: prime(1) = 2.
+    uint64_t prime(uint64_t i) const { return primes[i - 1]; }
+
+    uint64_t phi(uint64_t x, uint64_t a)
+    {
+        if (a == 0)
+            return x;
+        if (a <= SMALL_A)
+            return (x / small_q[a]) * small_phi[a][small_q[a]] + small_phi[a][x % small_q[a]];
+        if (x <= limit && prime(a) * prime(a) >= x)
+            return x == 0 ? 0 : (pi_table[x] >= a ? pi_table[x] - a + 1 : 1);
+        bool cached = x < MEMO_X && a < MEMO_A;
+        if (cached && memo[a * MEMO_X + x] >= 0)
+            return (uint64_t)memo[a * MEMO_X + x];
+        uint64_t r = phi(x, a - 1) - phi(x / prime(a), a - 1);
+        if (cached)
+            memo[a * MEMO_X + x] = (int32_t)r;
+        return r;
+    }
+
+    void build_small_phi()
+    {
+        small_q[0] = 1;
+        small_phi.assign(SMALL_A + 1, vector<uint16_t>());
+        for (int a = 1; a <= SMALL_A; a++) {
+            uint32_t q = small_q[a - 1] * primes[a - 1];
+            small_q[a] = q;
+            // keep only counts up to q; phi(q, a) fits in 16 bits for q <= 30030
+            vector<uint16_t> &t = small_phi[a];
+            t.assign(q + 1, 0);
+            uint16_t count = 0;
+            for (uint32_t r = 0; r <= q; r++) {
+                if (r > 0) {
+                    bool coprime = true;
+                    for (int i = 0; i < a; i++)
+                        if (r % primes[i] == 0) {
+                            coprime = false;
+                            break;
+                        }
+                    if (coprime)
+                        count++;
+                }
+                t[r] = count;
+            }
+        }
+    }
+
+    // Byte sieve of [0, limit] in segments shared between threads, then a
+    // running count.
+    void sieve_table(unsigned threads)
+    {
+        uint64_t root = isqrt(limit);
+        vector<char> small(root + 1, 1);
+        vector<uint32_t> base;
+        for (uint64_t i = 2; i <= root; i++) {
+            if (!small[i])
+                continue;
+            base.push_back((uint32_t)i);
+            for (uint64_t j = i * i; j <= root; j += i)
+                small[j] = 0;
+        }
+
+        vector<char> is_prime(limit + 1, 1);
+        is_prime[0] = is_prime[1] = 0;
+        const uint64_t SEG = 1 << 18;
+        uint64_t segments = (limit + SEG) / SEG;
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                for (uint64_t s = t; s < segments; s += threads) {
+                    uint64_t lo = s * SEG, hi = min(limit + 1, lo + SEG);
+                    for (uint32_t p : base) {
+                        uint64_t start = max<uint64_t>((uint64_t)p * p, (lo + p - 1) / p * p);
+                        for (uint64_t j = start; j < hi; j += p)
+                            is_prime[j] = 0;
+                    }
+                }
+            });
+        }
+        for (auto &th : pool)
+            th.join();
+
+        pi_table.assign(limit + 1, 0);
+        uint32_t count = 0;
+        for (uint64_t i = 0; i <= limit; i++) {
+            if (is_prime[i]) {
+                count++;
+                primes.push_back((uint32_t)i);
+            }
+            pi_table[i] = count;
+        }
+    }
+};
+
+// Plain segmented sieve count, for comparison.
+static uint64_t sieve_count(uint64_t x)
+{
+    if (x < 2)
+        return 0;
+    uint64_t root = isqrt(x);
+    vector<char> small(root + 1, 1);
+    vector<uint32_t> base;
+    for (uint64_t i = 2; i <= root; i++) {
+        if (!small[i])
+            continue;
+        base.push_back((uint32_t)i);
+        for (uint64_t j = i * i; j <= root; j += i)
+            small[j] = 0;
+    }
+    const uint64_t SEG = 1 << 18;
+    vector<char> seg(SEG);
+    uint64_t count = 0;
+    for (uint64_t lo = 0; lo <= x; lo += SEG) {
+        uint64_t hi = min(x + 1, lo + SEG);
+        fill(seg.begin(), seg.end(), 1);
+        for (uint32_t p : base) {
+            uint64_t start = max<uint64_t>((uint64_t)p * p, (lo + p - 1) / p * p);
+            for (uint64_t j = start; j < hi; j += p)
+                seg[j - lo] = 0;
+        }
+        for (uint64_t i = lo; i < hi; i++)
+            if (i >= 2 && seg[i - lo])
+                count++;
+    }
+    return count;
+}
+
+static double seconds_since(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t max_x = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000000000ULL;
+    uint64_t sieve_max = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000000ULL;
+
+    // exactly3Divisors(N) for N up to 1e18 needs pi(x) for x up to 1e9.
+    long long N = 1000000000000000000LL;
+    uint64_t x = isqrt((uint64_t)N);
+    auto t0 = chrono::steady_clock::now();
+    LehmerPi lp(LehmerPi::table_size_for(x));
+    uint64_t answer = lp.pi(x);
+    cout << "exactly3Divisors(1e18) = pi(" << x << ") = " << answer << " in "
+         << seconds_since(t0) << " s (table up to " << lp.table_limit() << ")\n";
+
+    // Force the recursive path with a tiny table and compare against a full one.
+    LehmerPi full(10000000), tiny(4000);
+    int bad = 0;
+    for (uint64_t v = 4001; v <= 10000000; v = v * 3 / 2 + 7)
+        if (tiny.pi(v) != full.pi(v))
+            bad++;
+    cout << "small-table Lehmer vs sieve table up to 1e7: " << bad << " mismatches\n\n";
+
+    cout << "x              Lehmer pi(x)   time      sieve pi(x)    time\n";
+    for (uint64_t v = 1000000; v <= max_x; v *= 10) {
+        t0 = chrono::steady_clock::now();
+        LehmerPi l(LehmerPi::table_size_for(v));
+        uint64_t a = l.pi(v);
+        double ta = seconds_since(t0);
+        cout << setw(14) << left << v << " " << setw(14) << a << " " << setw(9) << ta;
+        if (v <= sieve_max) {
+            t0 = chrono::steady_clock::now();
+            uint64_t b = sieve_count(v);
+            cout << " " << setw(14) << b << " " << seconds_since(t0) << (a == b ? "" : "  MISMATCH");
+        }
+        cout << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,394 @@
+// Deterministic Miller-Rabin primality test for 64-bit integers.
+// Replaces Solution::isPrime from 02_exactly_3_divisor.cpp, which trial-divides
+// up to sqrt(n) and reports 0 and 1 as prime.
+//
+//  - small-prime pre-filter: n divisible by a prime <= 53 is decided at once,
+//    which removes about 85% of random odd candidates before any exponentiation
+//  - Montgomery multiplication: a*b mod n as two multiplies and a shift, no
+//    division in the inner loop
+//  - bases: {2, 7, 61} are enough for n < 2^32; the 7 bases
+//    {2, 325, 9375, 28178, 450775, 9780504, 1795265022} cover all n < 2^64
+//  - batch API: candidates that survive the pre-filter are queued; those below
+//    2^32 run 4 at a time in AVX2 lanes (32x32->64 bit Montgomery per lane),
+//    the rest run 4 interleaved scalar chains so the multiplier stays busy
+//    (AVX2 has no 64x64->128 multiply)
+//
+// Build: g++ -O2 -mavx2 11_miller_rabin.cpp   (without -mavx2 the 32-bit
+// lanes fall back to the interleaved scalar path)
+//      Usage: ./a.out [count]
+#include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+typedef unsigned __int128 u128;
+
+// } Driver Code Ends
+//User function Template for C++
+
+class MillerRabin {
+public:
+    static bool isPrime(uint64_t n)
+    {
+        int r = prefilter(n);
+        if (r >= 0)
+            return r;
+        if (n < (1ull << 32)) {
+            static const uint64_t bases[3] = {2, 7, 61};
+            return test(n, bases, 3);
+        }
+        static const uint64_t bases[7] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+        return test(n, bases, 7);
+    }
+
+    // out[i] = isPrime(ns[i]). Works one base at a time over the whole queue
+    // and keeps only the candidates that pass, so most composites cost a single
+    // exponentiation, as in the scalar early exit.
+    static void isPrimeBatch(const uint64_t *ns, bool *out, size_t count)
+    {
+        // survivors of the pre-filter, split by size
+        vector<size_t> small_idx, big_idx;
+        for (size_t i = 0; i < count; i++) {
+            int r = prefilter(ns[i]);
+            out[i] = r == 1;
+            if (r < 0)
+                (ns[i] < (1ull << 32) ? small_idx : big_idx).push_back(i);
+        }
+
+        static const uint64_t small_bases[3] = {2, 7, 61};
+        for (uint64_t base : small_bases) {
+            size_t i = 0, kept = 0;
+#ifdef __AVX2__
+            for (; i + 4 <= small_idx.size(); i += 4) {
+                uint32_t n4[4];
+                for (int l = 0; l < 4; l++)
+                    n4[l] = (uint32_t)ns[small_idx[i + l]];
+                bool r4[4];
+                sprp32x4(n4, (uint32_t)base, r4);
+                for (int l = 0; l < 4; l++)
+                    if (r4[l])
+                        small_idx[kept++] = small_idx[i + l];
+            }
+#endif
+            kept = sprp_interleaved(ns, small_idx, i, kept, base);
+            small_idx.resize(kept);
+        }
+        static const uint64_t big_bases[7] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+        for (uint64_t base : big_bases)
+            big_idx.resize(sprp_interleaved(ns, big_idx, 0, 0, base));
+
+        for (size_t i : small_idx)
+            out[i] = true;
+        for (size_t i : big_idx)
+            out[i] = true;
+    }
+
+private:
+    // Montgomery arithmetic modulo an odd n, R = 2^64.
+    struct Mont {
+        uint64_t n, ninv, one, r2;  // ninv = n^-1 mod 2^64, one = R mod n, r2 = R^2 mod n
+
+        explicit Mont(uint64_t mod) : n(mod)
+        {
+            ninv = n;                           // Newton: 5 steps from 3 to 96 bits
+            for (int i = 0; i < 5; i++)
+                ninv *= 2 - n * ninv;
+            one = (uint64_t)(-n) % n;
+            r2 = (uint64_t)((u128)one * one % n);
+        }
+
+        // a*b*R^-1 mod n, for a, b < n
+        uint64_t mul(uint64_t a, uint64_t b) const
+        {
+            u128 t = (u128)a * b;
+            uint64_t m = (uint64_t)t * ninv;
+            uint64_t hi = (uint64_t)(t >> 64), mn = (uint64_t)(((u128)m * n) >> 64);
+            return hi >= mn ? hi - mn : hi - mn + n;
+        }
+
+        uint64_t to(uint64_t a) const { return mul(a % n, r2); }
+    };
+
+    // 1 = prime, 0 = composite, -1 = undecided.
+    static int prefilter(uint64_t n)
+    {
+        static const uint32_t small[16] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+        if (n < 2)
+            return 0;
+        for (uint32_t p : small) {
+            if (n == p)
+                return 1;
+            if (n % p == 0)
+                return 0;
+        }
+        if (n < 59 * 59)
+            return 1;
+        return -1;
+    }
+
+    static bool test(uint64_t n, const uint64_t *bases, int nb)
+    {
+        Mont m(n);
+        uint64_t d = n - 1;
+        int s = __builtin_ctzll(d);
+        d >>= s;
+        for (int b = 0; b < nb; b++)
+            if (!sprp(m, d, s, bases[b]))
+                return false;
+        return true;
+    }
+
+    // Strong probable prime to `base`: with n - 1 = d * 2^s, a^d == 1 or
+    // a^(d 2^r) == -1 for some r < s.
+    static bool sprp(const Mont &m, uint64_t d, int s, uint64_t base)
+    {
+        uint64_t a = base % m.n;
+        if (a == 0)
+            return true;
+        uint64_t minus_one = m.n - m.one;
+        uint64_t x = pow(m, m.to(a), d);
+        if (x == m.one || x == minus_one)
+            return true;
+        for (int r = 1; r < s; r++) {
+            x = m.mul(x, x);
+            if (x == minus_one)
+                return true;
+        }
+        return false;
+    }
+
+    static uint64_t pow(const Mont &m, uint64_t a, uint64_t e)
+    {
+        uint64_t r = m.one;
+        while (e) {
+            uint64_t ra = m.mul(r, a);
+            r = (e & 1) ? ra : r;
+            a = m.mul(a, a);
+            e >>= 1;
+        }
+        return r;
+    }
+
+    // Runs the `base` round on ns[idx[from..]], four candidates at a time with
+    // independent Montgomery chains advanced in lock step so the multiplies of
+    // different lanes overlap. Passing entries are moved to idx[kept..];
+    // returns the new kept count.
+    static size_t sprp_interleaved(const uint64_t *ns, vector<size_t> &idx, size_t from,
+                                   size_t kept, uint64_t base)
+    {
+        const int L = 4;
+        size_t i = from;
+        for (; i + L <= idx.size(); i += L) {
+            Mont m[L] = {Mont(ns[idx[i]]), Mont(ns[idx[i + 1]]), Mont(ns[idx[i + 2]]), Mont(ns[idx[i + 3]])};
+            uint64_t x[L], a[L], e[L];
+            int s[L];
+            for (int l = 0; l < L; l++) {
+                e[l] = m[l].n - 1;
+                s[l] = __builtin_ctzll(e[l]);
+                e[l] >>= s[l];
+                a[l] = m[l].to(base);
+                x[l] = m[l].one;
+            }
+            // exponentiation: lanes share the loop, finished lanes idle
+            for (;;) {
+                uint64_t any = 0;
+                for (int l = 0; l < L; l++) {
+                    uint64_t xa = m[l].mul(x[l], a[l]);     // select, not branch
+                    x[l] = (e[l] & 1) ? xa : x[l];
+                    a[l] = m[l].mul(a[l], a[l]);
+                    e[l] >>= 1;
+                    any |= e[l];
+                }
+                if (!any)
+                    break;
+            }
+            for (int l = 0; l < L; l++) {
+                uint64_t minus_one = m[l].n - m[l].one;
+                bool pass = base % m[l].n == 0 || x[l] == m[l].one || x[l] == minus_one;
+                for (int r = 1; r < s[l] && !pass; r++) {
+                    x[l] = m[l].mul(x[l], x[l]);
+                    pass = x[l] == minus_one;
+                }
+                if (pass)
+                    idx[kept++] = idx[i + l];
+            }
+        }
+        for (; i < idx.size(); i++) {
+            Mont m(ns[idx[i]]);
+            uint64_t d = m.n - 1;
+            int s = __builtin_ctzll(d);
+            if (sprp(m, d >> s, s, base))
+                idx[kept++] = idx[i];
+        }
+        return kept;
+    }
+
+#ifdef __AVX2__
+    // One Miller-Rabin round to `base` for four odd n < 2^32, one per 64-bit
+    // lane. Montgomery with R = 2^32: values live in the low 32 bits of a lane.
+    static void sprp32x4(const uint32_t *n4, uint32_t base, bool *out)
+    {
+        alignas(32) uint64_t nv[4], ninv[4], onev[4], m1v[4], dv[4];
+        int s[4], max_s = 0;
+        uint64_t max_d = 0;
+        for (int l = 0; l < 4; l++) {
+            uint32_t n = n4[l], inv = n;
+            for (int i = 0; i < 4; i++)
+                inv *= 2 - n * inv;
+            nv[l] = n;
+            ninv[l] = (uint32_t)(0u - inv);          // -n^-1 mod 2^32
+            onev[l] = (1ull << 32) % n;
+            m1v[l] = n - onev[l];
+            uint32_t d = n - 1;
+            s[l] = __builtin_ctz(d);
+            dv[l] = d >> s[l];
+            max_s = max(max_s, s[l]);
+            max_d = max(max_d, dv[l]);
+        }
+        const __m256i N = _mm256_load_si256((const __m256i *)nv);
+        const __m256i NINV = _mm256_load_si256((const __m256i *)ninv);
+        const __m256i ONE = _mm256_load_si256((const __m256i *)onev);
+        const __m256i M1 = _mm256_load_si256((const __m256i *)m1v);
+        const __m256i D = _mm256_load_si256((const __m256i *)dv);
+        const __m256i LOW = _mm256_set1_epi64x(0xffffffffll);
+        const __m256i ZERO = _mm256_setzero_si256();
+        const __m256i NM1 = _mm256_sub_epi64(N, _mm256_set1_epi64x(1));
+
+        // REDC(a*b): t = a*b, m = t*(-n^-1) mod 2^32, (t + m*n) / 2^32, then
+        // one conditional subtract. The high halves are added in 64-bit lanes
+        // so the sum (< 2n) cannot overflow even for n close to 2^32.
+        auto mul = [&](__m256i a, __m256i b) {
+            __m256i t = _mm256_mul_epu32(a, b);
+            __m256i m = _mm256_mul_epu32(t, NINV);
+            __m256i mn = _mm256_mul_epu32(m, N);
+            __m256i carry = _mm256_andnot_si256(_mm256_cmpeq_epi64(_mm256_and_si256(t, LOW), ZERO),
+                                                _mm256_set1_epi64x(1));
+            __m256i u = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(t, 32),
+                                                          _mm256_srli_epi64(mn, 32)), carry);
+            __m256i ge = _mm256_cmpgt_epi64(u, NM1);
+            return _mm256_sub_epi64(u, _mm256_and_si256(ge, N));
+        };
+
+        int bits = 64 - __builtin_clzll(max_d);
+        alignas(32) uint64_t av[4], skip[4];
+        for (int l = 0; l < 4; l++) {
+            uint64_t b = base % nv[l];
+            skip[l] = b == 0 ? ~0ull : 0;
+            av[l] = (b << 32) % nv[l];               // base in Montgomery form
+        }
+        __m256i a = _mm256_load_si256((const __m256i *)av);
+        __m256i x = ONE;
+        // left-to-right: same squaring schedule for all lanes, per-lane multiply
+        for (int bit = bits - 1; bit >= 0; bit--) {
+            x = mul(x, x);
+            __m256i set = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_srli_epi64(D, bit),
+                                                              _mm256_set1_epi64x(1)),
+                                             _mm256_set1_epi64x(1));
+            x = _mm256_blendv_epi8(x, mul(x, a), set);
+        }
+        // passes if x == 1 or x == -1, or x^(2^r) == -1 for some r < s
+        __m256i pass = _mm256_or_si256(_mm256_cmpeq_epi64(x, ONE), _mm256_cmpeq_epi64(x, M1));
+        pass = _mm256_or_si256(pass, _mm256_load_si256((const __m256i *)skip));
+        const __m256i S = _mm256_set_epi64x(s[3], s[2], s[1], s[0]);
+        for (int r = 1; r < max_s; r++) {
+            x = mul(x, x);
+            __m256i live = _mm256_cmpgt_epi64(S, _mm256_set1_epi64x(r));
+            pass = _mm256_or_si256(pass, _mm256_and_si256(live, _mm256_cmpeq_epi64(x, M1)));
+        }
+        alignas(32) uint64_t p[4];
+        _mm256_store_si256((__m256i *)p, pass);
+        for (int l = 0; l < 4; l++)
+            out[l] = p[l] != 0;
+    }
+#endif
+};
+
+class Solution{
+    public:
+    bool isPrime(long long n)
+    {
+        return n >= 2 && MillerRabin::isPrime((uint64_t)n);
+    }
+};
+
+//{ Driver Code Starts.
+
+static bool isPrimeTrial(uint64_t n)
+{
+    if (n < 2)
+        return false;
+    for (uint64_t i = 2; i * i <= n; i++)
+        if (n % i == 0)
+            return false;
+    return true;
+}
+
+static double seconds_since(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+    Solution ob;
+    cout << "isPrime(0) = " << ob.isPrime(0) << ", isPrime(1) = " << ob.isPrime(1) << "\n";
+
+    // Against a sieve for every n below LIMIT, scalar and batch.
+    const uint64_t LIMIT = 2000000;
+    vector<char> sieve(LIMIT, 1);
+    sieve[0] = sieve[1] = 0;
+    for (uint64_t i = 2; i * i < LIMIT; i++)
+        if (sieve[i])
+            for (uint64_t j = i * i; j < LIMIT; j += i)
+                sieve[j] = 0;
+    vector<uint64_t> all(LIMIT);
+    iota(all.begin(), all.end(), 0);
+    unique_ptr<bool[]> res(new bool[LIMIT]);
+    MillerRabin::isPrimeBatch(all.data(), res.get(), LIMIT);
+    size_t bad = 0;
+    for (uint64_t n = 0; n < LIMIT; n++)
+        bad += (MillerRabin::isPrime(n) != (bool)sieve[n]) + (res[n] != (bool)sieve[n]);
+    cout << "n < " << LIMIT << " against sieve: " << bad << " mismatches\n";
+
+    // Strong pseudoprimes to several small bases, and known primes near 2^64.
+    uint64_t hard[] = {3215031751ull, 2152302898747ull, 3474749660383ull, 341550071728321ull,
+                       3825123056546413051ull, 4294967291ull, 4294967297ull,
+                       18446744073709551557ull, 18446744073709551559ull, 1000000007ull * 998244353ull};
+    for (uint64_t n : hard)
+        cout << n << (MillerRabin::isPrime(n) ? " prime\n" : " composite\n");
+
+    // Random 32-bit and 64-bit candidates: trial division, scalar, batch.
+    mt19937_64 rng(12345);
+    for (int bitsz : {32, 64}) {
+        vector<uint64_t> v(count);
+        for (auto &x : v)
+            x = (bitsz == 32 ? rng() >> 32 : rng()) | 1;
+        unique_ptr<bool[]> a(new bool[count]), b(new bool[count]);
+        auto t0 = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++)
+            a[i] = MillerRabin::isPrime(v[i]);
+        double ts = seconds_since(t0);
+        t0 = chrono::steady_clock::now();
+        MillerRabin::isPrimeBatch(v.data(), b.get(), count);
+        double tb = seconds_since(t0);
+        size_t primes = 0, diff = 0;
+        for (size_t i = 0; i < count; i++) {
+            primes += a[i];
+            diff += a[i] != b[i];
+        }
+        cout << "\n" << count << " random odd " << bitsz << "-bit: " << primes << " primes\n"
+             << "  scalar Miller-Rabin " << ts << " s, batch " << tb << " s (" << diff
+             << " disagreements)\n";
+        if (bitsz == 32) {
+            size_t sample = min<size_t>(count, 20000), agree = 0;
+            t0 = chrono::steady_clock::now();
+            for (size_t i = 0; i < sample; i++)
+                agree += isPrimeTrial(v[i]) == a[i];
+            cout << "  trial division on " << sample << " of them: " << seconds_since(t0)
+                 << " s (" << sample - agree << " disagreements)\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,432 @@
+// Divisor engine: factorization, divisor count and divisor sum for 64-bit n,
+// generalising exactly3Divisors (02_exactly_3_divisor.cpp) to "which of these
+// N have exactly k divisors".
+//
+//  - smallest-prime-factor table up to a limit L, built either with the linear
+//    sieve (every composite written exactly once, single thread) or segment by
+//    segment on several threads (each segment crosses off with the base primes
+//    in increasing order, so the first write is the smallest factor)
+//  - n <= L factors in O(log n) by repeated spf lookups
+//  - n > L: trial division by the table primes up to a small bound, then
+//    Miller-Rabin and Brent's Pollard-rho on what is left
+//  - d(n) = prod (e_i + 1), sigma(n) = prod (p_i^(e_i+1) - 1) / (p_i - 1)
+//  - batch queries are split across threads; the table is read-only by then
+//
+//      Usage: ./a.out [L] [queries]
+#include <bits/stdc++.h>
+using namespace std;
+
+typedef unsigned __int128 u128;
+
+// } Driver Code Ends
+//User function Template for C++
+
+class DivisorEngine {
+    vector<uint32_t> spf;       // spf[n] = smallest prime factor of n, n >= 2
+    vector<uint32_t> primes;    // primes <= limit
+    uint64_t limit = 1;
+
+    // above the table, trial division stops here and Pollard-rho takes over
+    static const uint32_t TRIAL_BOUND = 1000;
+
+public:
+    struct Factor {
+        uint64_t p;
+        int e;
+    };
+
+    // Linear sieve: O(L), one pass, single thread.
+    void build_linear(uint64_t L)
+    {
+        limit = max<uint64_t>(L, 2);
+        spf.assign(limit + 1, 0);
+        primes.clear();
+        for (uint64_t i = 2; i <= limit; i++) {
+            if (spf[i] == 0) {
+                spf[i] = (uint32_t)i;
+                primes.push_back((uint32_t)i);
+            }
+            for (uint32_t p : primes) {
+                if (p > spf[i] || (uint64_t)p * i > limit)
+                    break;
+                spf[p * i] = p;
+            }
+        }
+    }
+
+    // Segmented build on `threads` threads: the same table, O(L log log L).
+    void build_parallel(uint64_t L, unsigned threads = thread::hardware_concurrency())
+    {
+        limit = max<uint64_t>(L, 2);
+        spf.assign(limit + 1, 0);
+        uint64_t root = (uint64_t)sqrtl((long double)limit);
+        while (root * root > limit)
+            root--;
+        while ((root + 1) * (root + 1) <= limit)
+            root++;
+        vector<uint32_t> base;
+        vector<char> small(root + 1, 1);
+        for (uint64_t i = 2; i <= root; i++) {
+            if (!small[i])
+                continue;
+            base.push_back((uint32_t)i);
+            for (uint64_t j = i * i; j <= root; j += i)
+                small[j] = 0;
+        }
+
+        const uint64_t SEG = 1 << 16;                   // 256 KB of uint32_t
+        uint64_t segments = limit / SEG + 1;
+        if (threads == 0)
+            threads = 1;
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                for (uint64_t s = t; s < segments; s += threads) {
+                    uint64_t lo = max<uint64_t>(s * SEG, 2), hi = min(limit + 1, (s + 1) * SEG);
+                    for (uint32_t p : base) {
+                        uint64_t start = max<uint64_t>((uint64_t)p * p, (lo + p - 1) / p * p);
+                        for (uint64_t j = start; j < hi; j += p)
+                            if (spf[j] == 0)
+                                spf[j] = p;
+                    }
+                    for (uint64_t j = lo; j < hi; j++)
+                        if (spf[j] == 0)
+                            spf[j] = (uint32_t)j;
+                }
+            });
+        }
+        for (auto &th : pool)
+            th.join();
+
+        primes.clear();
+        for (uint64_t i = 2; i <= limit; i++)
+            if (spf[i] == i)
+                primes.push_back((uint32_t)i);
+    }
+
+    uint64_t table_limit() const { return limit; }
+    uint32_t smallest_factor(uint64_t n) const { return spf[n]; }
+
+    // Calls fn(p, e) for each prime power p^e exactly dividing n, in increasing
+    // order of p. Nothing is allocated when n <= table_limit().
+    template <class F>
+    void for_each_factor(uint64_t n, F fn) const
+    {
+        if (n < 2)
+            return;
+        if (n > limit) {
+            // strip small table primes, then split whatever is left with rho
+            for (uint32_t p : primes) {
+                if (p > TRIAL_BOUND || (uint64_t)p * p > n)
+                    break;
+                if (n % p == 0) {
+                    int e = 0;
+                    while (n % p == 0) {
+                        n /= p;
+                        e++;
+                    }
+                    fn((uint64_t)p, e);
+                }
+            }
+            if (n > limit) {
+                vector<uint64_t> big;
+                split(n, big);
+                sort(big.begin(), big.end());
+                for (size_t i = 0; i < big.size();) {
+                    size_t j = i;
+                    while (j < big.size() && big[j] == big[i])
+                        j++;
+                    fn(big[i], (int)(j - i));
+                    i = j;
+                }
+                return;
+            }
+        }
+        while (n > 1) {
+            uint32_t p = spf[n];
+            int e = 0;
+            do {
+                n /= p;
+                e++;
+            } while (spf[n] == p && n > 1);
+            fn((uint64_t)p, e);
+        }
+    }
+
+    // Prime factorization in increasing order of p. factor(0) and factor(1) are empty.
+    vector<Factor> factor(uint64_t n) const
+    {
+        vector<Factor> f;
+        for_each_factor(n, [&](uint64_t p, int e) { f.push_back(Factor{p, e}); });
+        return f;
+    }
+
+    uint64_t divisor_count(uint64_t n) const
+    {
+        if (n == 0)
+            return 0;
+        uint64_t d = 1;
+        for_each_factor(n, [&](uint64_t, int e) { d *= (uint64_t)e + 1; });
+        return d;
+    }
+
+    // sigma(n); 128-bit because sigma(n) can exceed 2^64 for n near 2^64.
+    u128 divisor_sum(uint64_t n) const
+    {
+        if (n == 0)
+            return 0;
+        u128 s = 1;
+        for_each_factor(n, [&](uint64_t p, int e) {
+            u128 term = 1, pk = 1;
+            for (int i = 0; i < e; i++) {
+                pk *= p;
+                term += pk;
+            }
+            s *= term;
+        });
+        return s;
+    }
+
+    // out[i] = (divisor_count(ns[i]) == k), queries split across threads.
+    void has_k_divisors(const uint64_t *ns, size_t count, uint64_t k, bool *out,
+                        unsigned threads = thread::hardware_concurrency()) const
+    {
+        for_each_parallel(count, threads, [&](size_t i) { out[i] = divisor_count(ns[i]) == k; });
+    }
+
+    // out[i] = divisor_count(ns[i]).
+    void divisor_counts(const uint64_t *ns, size_t count, uint64_t *out,
+                        unsigned threads = thread::hardware_concurrency()) const
+    {
+        for_each_parallel(count, threads, [&](size_t i) { out[i] = divisor_count(ns[i]); });
+    }
+
+    static bool is_prime(uint64_t n)
+    {
+        if (n < 2)
+            return false;
+        static const uint64_t small[12] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+        for (uint64_t p : small)
+            if (n % p == 0)
+                return n == p;
+        uint64_t d = n - 1;
+        int s = __builtin_ctzll(d);
+        d >>= s;
+        // first 12 primes as bases: deterministic for n < 3.3e24
+        for (uint64_t a : small) {
+            uint64_t x = pow_mod(a, d, n);
+            if (x == 1 || x == n - 1)
+                continue;
+            bool composite = true;
+            for (int r = 1; r < s && composite; r++) {
+                x = mul_mod(x, x, n);
+                composite = x != n - 1;
+            }
+            if (composite)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    template <class F>
+    static void for_each_parallel(size_t count, unsigned threads, F fn)
+    {
+        if (threads == 0)
+            threads = 1;
+        threads = (unsigned)min<size_t>(threads, max<size_t>(count / 4096, 1));
+        if (threads == 1) {
+            for (size_t i = 0; i < count; i++)
+                fn(i);
+            return;
+        }
+        vector<thread> pool;
+        size_t chunk = (count + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; t++) {
+            size_t lo = t * chunk, hi = min(count, lo + chunk);
+            pool.emplace_back([=]() {
+                for (size_t i = lo; i < hi; i++)
+                    fn(i);
+            });
+        }
+        for (auto &th : pool)
+            th.join();
+    }
+
+    static uint64_t mul_mod(uint64_t a, uint64_t b, uint64_t m) { return (uint64_t)((u128)a * b % m); }
+
+    static uint64_t pow_mod(uint64_t a, uint64_t e, uint64_t m)
+    {
+        uint64_t r = 1;
+        a %= m;
+        while (e) {
+            if (e & 1)
+                r = mul_mod(r, a, m);
+            a = mul_mod(a, a, m);
+            e >>= 1;
+        }
+        return r;
+    }
+
+    // Appends the prime factors of n (with repetition, unsorted).
+    static void split(uint64_t n, vector<uint64_t> &out)
+    {
+        if (n == 1)
+            return;
+        if (is_prime(n)) {
+            out.push_back(n);
+            return;
+        }
+        uint64_t d = rho(n);
+        split(d, out);
+        split(n / d, out);
+    }
+
+    // Brent's variant of Pollard-rho: returns a non-trivial factor of composite n.
+    // gcds are batched over 128 steps; on failure it backtracks one step at a time.
+    static uint64_t rho(uint64_t n)
+    {
+        if (n % 2 == 0)
+            return 2;
+        for (uint64_t c = 1;; c++) {
+            auto f = [&](uint64_t x) { return (mul_mod(x, x, n) + c) % n; };
+            uint64_t y = 2, x = 2, ys = 2, q = 1, g = 1;
+            const uint64_t M = 128;
+            for (uint64_t r = 1; g == 1; r <<= 1) {
+                x = y;
+                for (uint64_t i = 0; i < r; i++)
+                    y = f(y);
+                for (uint64_t k = 0; k < r && g == 1; k += M) {
+                    ys = y;
+                    for (uint64_t i = 0; i < min(M, r - k); i++) {
+                        y = f(y);
+                        q = mul_mod(q, x > y ? x - y : y - x, n);
+                    }
+                    g = __gcd(q, n);
+                }
+            }
+            if (g == n) {
+                do {
+                    ys = f(ys);
+                    g = __gcd(x > ys ? x - ys : ys - x, n);
+                } while (g == 1);
+            }
+            if (g != n)
+                return g;
+        }
+    }
+};
+
+class Solution{
+    public:
+    const DivisorEngine *engine;
+
+    // Numbers in [1, N] with exactly 3 divisors, checked one by one through the
+    // engine (02_exactly_3_divisor.cpp counts primes <= sqrt(N) instead).
+    int exactly3Divisors(int N)
+    {
+        int count = 0;
+        for (long long i = 2; i * i <= N; i++)
+            if (engine->divisor_count((uint64_t)(i * i)) == 3)
+                count++;
+        return count;
+    }
+};
+
+//{ Driver Code Starts.
+
+static double seconds_since(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+static uint64_t divisor_count_naive(uint64_t n)
+{
+    uint64_t d = 0;
+    for (uint64_t i = 1; i * i <= n; i++)
+        if (n % i == 0)
+            d += (i * i == n) ? 1 : 2;
+    return d;
+}
+
+static string to_string128(u128 v)
+{
+    string s;
+    do {
+        s += (char)('0' + (int)(v % 10));
+        v /= 10;
+    } while (v > 0);
+    return string(s.rbegin(), s.rend());
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t L = argc > 1 ? strtoull(argv[1], nullptr, 10) : 50000000;
+    size_t queries = argc > 2 ? strtoull(argv[2], nullptr, 10) : 2000000;
+
+    DivisorEngine lin, par;
+    auto t0 = chrono::steady_clock::now();
+    lin.build_linear(L);
+    double tl = seconds_since(t0);
+    t0 = chrono::steady_clock::now();
+    par.build_parallel(L);
+    double tp = seconds_since(t0);
+    size_t diff = 0;
+    for (uint64_t n = 2; n <= L; n++)
+        diff += lin.smallest_factor(n) != par.smallest_factor(n);
+    cout << "spf table up to " << L << ": linear " << tl << " s, segmented on "
+         << thread::hardware_concurrency() << " thread(s) " << tp << " s, " << diff << " differences\n";
+
+    const DivisorEngine &eng = par;
+    size_t bad = 0;
+    for (uint64_t n = 1; n <= 100000; n++)
+        bad += eng.divisor_count(n) != divisor_count_naive(n);
+    cout << "d(n) against trial division for n <= 100000: " << bad << " mismatches\n";
+
+    Solution ob;
+    ob.engine = &eng;
+    cout << "exactly3Divisors(1000000) = " << ob.exactly3Divisors(1000000) << " (pi(1000) = 168)\n\n";
+
+    uint64_t big[] = {600851475143ull, 1000000007ull * 998244353ull, 9223372036854775783ull,
+                      18446744073709551615ull, 4294967291ull * 4294967279ull, 963761198400ull};
+    for (uint64_t n : big) {
+        cout << n << " =";
+        for (const auto &f : eng.factor(n))
+            cout << " " << f.p << (f.e > 1 ? "^" + to_string(f.e) : "");
+        cout << "  d = " << eng.divisor_count(n) << ", sigma = " << to_string128(eng.divisor_sum(n)) << "\n";
+    }
+
+    // Batch: which of these have exactly k divisors.
+    mt19937_64 rng(7);
+    vector<uint64_t> small_q(queries), big_q(queries / 20);
+    for (auto &x : small_q)
+        x = rng() % L + 1;
+    for (auto &x : big_q)
+        x = rng() >> 4;
+    unique_ptr<bool[]> hit(new bool[queries]);
+    for (uint64_t k : {2, 3, 4, 12}) {
+        t0 = chrono::steady_clock::now();
+        eng.has_k_divisors(small_q.data(), small_q.size(), k, hit.get());
+        double ts = seconds_since(t0);
+        size_t hits = 0;
+        for (size_t i = 0; i < small_q.size(); i++)
+            hits += hit[i];
+        cout << "\n" << small_q.size() << " queries <= " << L << ", k = " << k << ": " << hits
+             << " hits, " << ts << " s";
+    }
+    size_t sample = min<size_t>(small_q.size(), 20000), agree = 0;
+    t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < sample; i++)
+        agree += divisor_count_naive(small_q[i]) == eng.divisor_count(small_q[i]);
+    cout << "\ntrial-division d(n) on " << sample << " of them: " << seconds_since(t0) << " s ("
+         << sample - agree << " disagreements)\n";
+
+    t0 = chrono::steady_clock::now();
+    eng.has_k_divisors(big_q.data(), big_q.size(), 4, hit.get());
+    size_t hits = 0;
+    for (size_t i = 0; i < big_q.size(); i++)
+        hits += hit[i];
+    cout << big_q.size() << " random 60-bit queries (Pollard-rho), k = 4: " << hits << " hits, "
+         << seconds_since(t0) << " s\n";
+    return 0;
+}
@@ -0,0 +1,547 @@
+// https://www.geeksforgeeks.org/batch/dsa-4/track/DSASP-Mathematics/problem/gp-term
+// Exact version of 03_geometric_progression.cpp.
+//
+// termOfGP there computes a * pow(b/a, n-1) in double and main() floors it, so
+// once the term passes 2^53 (or b/a is not exact in binary) the printed value
+// is wrong. Here the ratio is kept as a reduced fraction r = p/q and
+//   term(n) = a * p^(n-1) / q^(n-1)
+//   sum(n)  = a + a r + ... + a r^(n-1) = a (p^n - q^n) / (q^(n-1) (p - q))
+// are computed exactly. A result is flagged only when its reduced numerator or
+// denominator does not fit in 128 bits: the denominator is q^(n-1) with the
+// factors it shares with a divided out one power of q at a time, and the sum's
+// numerator p^(n-1) + p^(n-2) q + ... + q^(n-1) is built by Horner's rule in a
+// 256-bit scratch integer, so neither p^n nor q^n has to fit.
+//
+// Modular mode works modulo an odd m (a prime for the usual 1e9+7 style
+// questions; Montgomery reduction needs m odd, even m is rejected) in Montgomery
+// form, where r = b * a^-1 and the prefix sum uses
+// the doubling identity
+//   S(2k) = S(k) (1 + r^k),  S(k+1) = 1 + r S(k)
+// which needs no inverse of (r - 1), so r == 1 needs no special case.
+//
+// The batch evaluators take arrays of (a, b, n) and build the Montgomery
+// constants for the modulus once.
+//      Usage: ./a.out [queries]
+#include <bits/stdc++.h>
+using namespace std;
+
+typedef __int128 i128;
+typedef unsigned __int128 u128;
+
+// } Driver Code Ends
+//User function Template for C++
+
+struct GPQuery {
+    int64_t a, b, n;       // first term, second term, index (n >= 1)
+};
+
+// num / den in lowest terms with den > 0. ok is false if a value did not fit
+// in 128 bits or the query was invalid (a == 0 or n < 1).
+struct Rational {
+    i128 num = 0, den = 1;
+    bool ok = false;
+
+    bool integral() const { return ok && den == 1; }
+
+    i128 floor() const
+    {
+        i128 q = num / den;
+        if (num % den != 0 && num < 0)
+            q--;
+        return q;
+    }
+};
+
+// Signed 256-bit two's complement scratch integer: just enough for Horner's
+// rule on the prefix-sum numerator, whose intermediates can pass 2^128 even
+// when the final value does not.
+struct Int256 {
+    uint64_t w[4];
+
+    static Int256 from(i128 v)
+    {
+        u128 u = (u128)v;
+        uint64_t ext = v < 0 ? ~0ull : 0;
+        return Int256{{(uint64_t)u, (uint64_t)(u >> 64), ext, ext}};
+    }
+
+    void add(const Int256 &o)
+    {
+        unsigned char c = 0;
+        for (int i = 0; i < 4; i++) {
+            u128 t = (u128)w[i] + o.w[i] + c;
+            w[i] = (uint64_t)t;
+            c = (unsigned char)(t >> 64);
+        }
+    }
+
+    void negate()
+    {
+        for (uint64_t &x : w)
+            x = ~x;
+        add(Int256{{1, 0, 0, 0}});
+    }
+
+    // *this *= (negative ? -mag : mag); exact while |result| < 2^255
+    void mul(uint64_t mag, bool negative)
+    {
+        u128 carry = 0;
+        for (uint64_t &x : w) {
+            u128 t = (u128)x * mag + carry;
+            x = (uint64_t)t;
+            carry = t >> 64;
+        }
+        if (negative)
+            negate();
+    }
+
+    bool fits_i128() const
+    {
+        uint64_t ext = (int64_t)w[1] < 0 ? ~0ull : 0;
+        return w[2] == ext && w[3] == ext;
+    }
+
+    i128 to_i128() const { return (i128)(((u128)w[1] << 64) | w[0]); }
+};
+
+class GPExact {
+public:
+    static Rational term(int64_t a, int64_t b, int64_t n)
+    {
+        Rational r;
+        i128 p, q, a_red, den, P;
+        if (!ratio(a, b, n, p, q) || !reduced_den(a, q, n - 1, a_red, den))
+            return r;
+        // gcd(p, q) == 1, so nothing in p^(n-1) cancels: its overflow is real
+        if (!pow_checked(p, n - 1, P) || __builtin_mul_overflow(a_red, P, &r.num))
+            return r;
+        r.den = den;
+        r.ok = true;
+        return r;
+    }
+
+    // a + a r + ... + a r^(n-1) = a N / q^(n-1), N = p^(n-1) + p^(n-2) q + ... + q^(n-1)
+    static Rational prefix_sum(int64_t a, int64_t b, int64_t n)
+    {
+        Rational r;
+        i128 p, q;
+        if (!ratio(a, b, n, p, q))
+            return r;
+        if (p == q) {                               // r == 1
+            if (__builtin_mul_overflow((i128)a, (i128)n, &r.num))
+                return r;
+            r.ok = true;
+            return r;
+        }
+        i128 mp = p < 0 ? -p : p, mq = q, big = max(mp, mq);
+        Int256 N = Int256::from(1);
+        if (big == 1) {
+            // q = 1 and p = 0 (a, 0, 0, ...) or p = -1 (a, -a, a, ...)
+            if (p == -1 && n % 2 == 0)
+                N = Int256::from(0);
+        }
+        else {
+            // |p^n - q^n| >= big^(n-1) and |p - q| < 2 big, so |N| > big^(n-2) / 2:
+            // big^(n-2) >= 2^128 means N cannot fit. Otherwise big^(n-1) < 2^192
+            // and every Horner intermediate stays far below 2^255.
+            u128 bound = 1;
+            for (int64_t k = 0; k < n - 2; k++)
+                if (__builtin_mul_overflow(bound, (u128)big, &bound))
+                    return r;
+            // N(k+1) = p N(k) + q^k
+            Int256 qk = Int256::from(1);
+            for (int64_t k = 1; k < n; k++) {
+                N.mul((uint64_t)mp, p < 0);
+                qk.mul((uint64_t)mq, false);
+                N.add(qk);
+            }
+        }
+        // gcd(N, q) == 1 (N = p^(n-1) mod q), so only a and q^(n-1) cancel
+        i128 a_red, den;
+        if (!reduced_den(a, q, n - 1, a_red, den))
+            return r;
+        N.mul((uint64_t)(a_red < 0 ? -a_red : a_red), a_red < 0);
+        if (!N.fits_i128())
+            return r;
+        r.num = N.to_i128();
+        r.den = den;
+        r.ok = true;
+        return r;
+    }
+
+    static void term_batch(const GPQuery *qs, size_t count, Rational *out)
+    {
+        for (size_t i = 0; i < count; i++)
+            out[i] = term(qs[i].a, qs[i].b, qs[i].n);
+    }
+
+private:
+    // r = b / a = p / q reduced, q > 0.
+    static bool ratio(int64_t a, int64_t b, int64_t n, i128 &p, i128 &q)
+    {
+        if (a == 0 || n < 1)
+            return false;
+        i128 g = gcd(a, b);
+        p = (i128)b / g;
+        q = (i128)a / g;
+        if (q < 0) {
+            p = -p;
+            q = -q;
+        }
+        return true;
+    }
+
+    static i128 gcd(i128 x, i128 y)
+    {
+        if (x < 0)
+            x = -x;
+        if (y < 0)
+            y = -y;
+        while (y != 0) {
+            i128 t = x % y;
+            x = y;
+            y = t;
+        }
+        return x;
+    }
+
+    // g = gcd(a, q^e): a_red = a / g and den = q^e / g, built one factor of q at
+    // a time so q^e itself never has to fit. false if den does not fit.
+    static bool reduced_den(int64_t a, i128 q, int64_t e, i128 &a_red, i128 &den)
+    {
+        a_red = a;
+        den = 1;
+        if (q == 1)
+            return true;
+        for (int64_t k = 0; k < e; k++) {
+            i128 h = gcd(a_red, q);
+            a_red /= h;
+            if (__builtin_mul_overflow(den, q / h, &den))
+                return false;
+        }
+        return true;
+    }
+
+    // base^e with overflow detection, e >= 0.
+    static bool pow_checked(i128 base, int64_t e, i128 &out)
+    {
+        i128 r = 1;
+        // |base| <= 1 never grows, and also keeps huge e cheap
+        if (base == 0 || base == 1 || base == -1) {
+            out = e == 0 ? 1 : (base == -1 ? ((e & 1) ? -1 : 1) : base);
+            return true;
+        }
+        while (true) {
+            if ((e & 1) && __builtin_mul_overflow(r, base, &r))
+                return false;
+            e >>= 1;
+            if (e == 0)
+                break;
+            if (__builtin_mul_overflow(base, base, &base))
+                return false;
+        }
+        out = r;
+        return true;
+    }
+};
+
+// Montgomery arithmetic modulo an odd m, 1 < m < 2^63, R = 2^64. Any other m
+// has no inverse mod 2^64 (or overflows to()); valid() is then false and every
+// query returns false.
+class GPMod {
+    uint64_t m, minv = 0, r1 = 0, r2 = 0;   // minv = m^-1 mod 2^64, r1 = R mod m, r2 = R^2 mod m
+    bool usable;
+
+public:
+    explicit GPMod(uint64_t mod) : m(mod), usable(mod > 1 && (mod & 1) && mod < (1ull << 63))
+    {
+        if (!usable)
+            return;
+        minv = m;
+        for (int i = 0; i < 5; i++)
+            minv *= 2 - m * minv;
+        r1 = (uint64_t)(-m) % m;
+        r2 = (uint64_t)((u128)r1 * r1 % m);
+    }
+
+    bool valid() const { return usable; }
+
+    // term(n) mod m; returns false if a has no inverse mod m.
+    bool term(int64_t a, int64_t b, int64_t n, uint64_t &out) const
+    {
+        uint64_t A, R;
+        if (!usable || n < 1 || !setup(a, b, A, R))
+            return false;
+        out = from(mul(A, pow(R, (uint64_t)(n - 1))));
+        return true;
+    }
+
+    bool prefix_sum(int64_t a, int64_t b, int64_t n, uint64_t &out) const
+    {
+        uint64_t A, R;
+        if (!usable || n < 1 || !setup(a, b, A, R))
+            return false;
+        uint64_t S, Rn;
+        series(R, (uint64_t)n, S, Rn);
+        out = from(mul(A, S));
+        return true;
+    }
+
+    // ok[i] is false where a has no inverse mod m.
+    void term_batch(const GPQuery *qs, size_t count, uint64_t *out, bool *ok) const
+    {
+        for (size_t i = 0; i < count; i++)
+            ok[i] = term(qs[i].a, qs[i].b, qs[i].n, out[i]);
+    }
+
+    void prefix_sum_batch(const GPQuery *qs, size_t count, uint64_t *out, bool *ok) const
+    {
+        for (size_t i = 0; i < count; i++)
+            ok[i] = prefix_sum(qs[i].a, qs[i].b, qs[i].n, out[i]);
+    }
+
+private:
+    uint64_t mul(uint64_t a, uint64_t b) const
+    {
+        u128 t = (u128)a * b;
+        uint64_t q = (uint64_t)t * minv;
+        uint64_t hi = (uint64_t)(t >> 64), qm = (uint64_t)(((u128)q * m) >> 64);
+        return hi >= qm ? hi - qm : hi - qm + m;
+    }
+
+    uint64_t add(uint64_t a, uint64_t b) const
+    {
+        uint64_t s = a + b;
+        return s >= m ? s - m : s;
+    }
+
+    uint64_t to(int64_t v) const
+    {
+        int64_t r = v % (int64_t)m;
+        return mul(r < 0 ? (uint64_t)(r + (int64_t)m) : (uint64_t)r, r2);
+    }
+
+    uint64_t from(uint64_t x) const { return mul(x, 1); }
+
+    uint64_t pow(uint64_t x, uint64_t e) const
+    {
+        uint64_t r = r1;
+        while (e) {
+            if (e & 1)
+                r = mul(r, x);
+            x = mul(x, x);
+            e >>= 1;
+        }
+        return r;
+    }
+
+    // A = a, R = b / a, both in Montgomery form.
+    bool setup(int64_t a, int64_t b, uint64_t &A, uint64_t &R) const
+    {
+        A = to(a);
+        uint64_t inv;
+        if (!inverse(a, inv))
+            return false;
+        R = mul(to(b), to((int64_t)inv));
+        return true;
+    }
+
+    // a^-1 mod m by the extended Euclidean algorithm (m need not be prime).
+    bool inverse(int64_t a, uint64_t &out) const
+    {
+        // Bezout coefficients stay below m in magnitude, so 64 bits suffice
+        int64_t r = a % (int64_t)m;
+        int64_t old_r = r < 0 ? r + (int64_t)m : r, cur_r = (int64_t)m;
+        int64_t old_s = 1, cur_s = 0;
+        while (cur_r != 0) {
+            int64_t q = old_r / cur_r, t = old_r - q * cur_r;
+            old_r = cur_r;
+            cur_r = t;
+            t = old_s - q * cur_s;
+            old_s = cur_s;
+            cur_s = t;
+        }
+        if (old_r != 1)
+            return false;
+        out = (uint64_t)(old_s < 0 ? old_s + (int64_t)m : old_s);
+        return true;
+    }
+
+    // S = 1 + R + ... + R^(k-1) and Rk = R^k, by doubling from the top bit of k.
+    void series(uint64_t R, uint64_t k, uint64_t &S, uint64_t &Rk) const
+    {
+        S = 0;
+        Rk = r1;
+        for (int bit = 63 - __builtin_clzll(k); bit >= 0; bit--) {
+            S = mul(S, add(r1, Rk));               // S(2j) = S(j) (1 + R^j)
+            Rk = mul(Rk, Rk);
+            if ((k >> bit) & 1) {
+                S = add(r1, mul(R, S));             // S(j+1) = 1 + R S(j)
+                Rk = mul(Rk, R);
+            }
+        }
+    }
+};
+
+class Solution{
+    public:
+    // out = floor of the n-th term, exact; false if it does not fit in 64 bits.
+    bool termOfGP(int a,int b,int n,long long &out)
+    {
+        Rational t = GPExact::term(a, b, n);
+        if (!t.ok)
+            return false;
+        i128 f = t.floor();
+        if (f > LLONG_MAX || f < LLONG_MIN)
+            return false;
+        out = (long long)f;
+        return true;
+    }
+};
+
+//{ Driver Code Starts.
+
+static string to_string128(i128 v)
+{
+    if (v == 0)
+        return "0";
+    bool neg = v < 0;
+    u128 u = neg ? -(u128)v : (u128)v;
+    string s;
+    while (u > 0) {
+        s += (char)('0' + (int)(u % 10));
+        u /= 10;
+    }
+    if (neg)
+        s += '-';
+    return string(s.rbegin(), s.rend());
+}
+
+static string show(const Rational &r)
+{
+    if (!r.ok)
+        return "overflow";
+    return to_string128(r.num) + (r.den == 1 ? "" : "/" + to_string128(r.den));
+}
+
+static double seconds_since(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000000;
+
+    // Where the double version goes wrong.
+    GPQuery samples[] = {{2, 6, 30}, {3, 9, 39}, {1, 3, 40}, {7, 21, 25}, {4, 6, 5}, {-2, 4, 11},
+                         {5, 10, 100}, {9, 3, 5}, {1, 2, 127}, {1, 2, 128},
+                         {1, -2, 128}, {1ll << 62, 1ll << 61, 131}};
+    cout << "a b n: exact term / floor / double floor / prefix sum\n";
+    for (const GPQuery &q : samples) {
+        Rational t = GPExact::term(q.a, q.b, q.n);
+        double r = (1.0 * q.b) / q.a;
+        double d = floor(q.a * pow(r, q.n - 1));
+        cout << q.a << " " << q.b << " " << q.n << ": " << show(t) << " / "
+             << (t.ok ? to_string128(t.floor()) : "-") << " / " << fixed << setprecision(0) << d
+             << " / " << show(GPExact::prefix_sum(q.a, q.b, q.n)) << "\n";
+    }
+
+    // Exact vs modular vs brute force for small n.
+    const uint64_t MOD = 1000000007;
+    GPMod gm(MOD);
+    size_t bad = 0;
+    for (int64_t a = -6; a <= 6; a++) {
+        for (int64_t b = -9; b <= 9; b++) {
+            for (int64_t n = 1; n <= 20 && a != 0; n++) {
+                Rational t = GPExact::term(a, b, n), s = GPExact::prefix_sum(a, b, n);
+                // brute force over the common denominator a^(n-1):
+                // term = b^(n-1) / a^(n-2), sum = sum_k b^k a^(n-k) / a^(n-1)
+                i128 tn = a, td = 1, sn = 0, sd = 1;
+                for (int64_t k = 1; k < n; k++) {
+                    tn *= b;
+                    td *= a;
+                    sd *= a;
+                }
+                for (int64_t k = 0; k < n; k++) {
+                    i128 v = a;
+                    for (int64_t j = 0; j < k; j++)
+                        v *= b;
+                    for (int64_t j = k; j < n - 1; j++)
+                        v *= a;
+                    sn += v;
+                }
+                // compare s = sn / sd and t = tn / td by cross-multiplying
+                if (!t.ok || !s.ok || t.num * td != tn * t.den || s.num * sd != sn * s.den)
+                    bad++;
+                uint64_t tm, sm;
+                bool ok = gm.term(a, b, n, tm) && gm.prefix_sum(a, b, n, sm);
+                auto mod_of = [&](const Rational &x) {
+                    i128 v = x.num % (i128)MOD;
+                    uint64_t inv = 1, base = (uint64_t)(x.den % MOD), e = MOD - 2;
+                    while (e) {
+                        if (e & 1)
+                            inv = (uint64_t)((u128)inv * base % MOD);
+                        base = (uint64_t)((u128)base * base % MOD);
+                        e >>= 1;
+                    }
+                    return (uint64_t)((u128)(v < 0 ? v + MOD : v) * inv % MOD);
+                };
+                if (!ok || tm != mod_of(t) || sm != mod_of(s))
+                    bad++;
+            }
+        }
+    }
+    cout << "\nterm and prefix sum, exact vs brute force vs mod 1e9+7: " << bad << " mismatches\n";
+    GPMod even(1000000006);
+    uint64_t unused;
+    cout << "GPMod(1000000006): valid " << even.valid() << ", term(1, 2, 5) "
+         << (even.term(1, 2, 5, unused) ? "answered" : "rejected") << "\n";
+
+    // (-2)^63 is LLONG_MIN itself, a valid answer; one past it does not fit.
+    Solution ob;
+    long long v;
+    bool fits = ob.termOfGP(1, -2, 64, v);
+    cout << "termOfGP(1, -2, 64): " << (fits ? to_string(v) : "overflow");
+    fits = ob.termOfGP(1, -2, 65, v);
+    cout << ", termOfGP(1, -2, 65): " << (fits ? to_string(v) : "overflow") << "\n";
+
+    // Batch throughput.
+    mt19937_64 rng(3);
+    vector<GPQuery> qs(count);
+    for (auto &q : qs) {
+        q.a = (int64_t)(rng() % 1000) + 1;
+        q.b = q.a * (int64_t)(rng() % 5 + 1);
+        q.n = (int64_t)(rng() % 40) + 1;
+    }
+    vector<Rational> ex(count);
+    auto t0 = chrono::steady_clock::now();
+    GPExact::term_batch(qs.data(), count, ex.data());
+    double te = seconds_since(t0);
+    size_t exact_ok = 0, double_wrong = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!ex[i].ok)
+            continue;
+        exact_ok++;
+        double r = (1.0 * qs[i].b) / qs[i].a;
+        double d = floor(qs[i].a * pow(r, qs[i].n - 1));
+        if ((i128)d != ex[i].floor())
+            double_wrong++;
+    }
+    vector<uint64_t> out(count);
+    unique_ptr<bool[]> ok(new bool[count]);
+    t0 = chrono::steady_clock::now();
+    gm.term_batch(qs.data(), count, out.data(), ok.get());
+    double tm = seconds_since(t0);
+    for (auto &q : qs)
+        q.n = (int64_t)(rng() >> 4);                // huge n only makes sense mod m
+    t0 = chrono::steady_clock::now();
+    gm.prefix_sum_batch(qs.data(), count, out.data(), ok.get());
+    double ts = seconds_since(t0);
+    cout << defaultfloat << setprecision(6) << "\n" << count << " random queries (n <= 40):\n"
+         << "  exact terms " << te << " s, " << exact_ok << " fit in 128 bits, double floor wrong on "
+         << double_wrong << " of them\n"
+         << "  terms mod 1e9+7 " << tm << " s\n"
+         << "  prefix sums mod 1e9+7 with n up to 2^60: " << ts << " s\n";
+    return 0;
+}
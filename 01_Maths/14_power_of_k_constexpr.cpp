@@ -0,0 +1,266 @@
+// Power-of-k checks resolved at compile time, for any base k.
+// 04_power_of_two.cpp, 05_power_of_three.cpp and 06_power_of_4.cpp each divide
+// in a loop, O(log n) divisions per call. PowerOf<K> picks a division-free (or
+// single-division) test when the program is compiled:
+//
+//  - k a power of two:  n > 0, exactly one bit set, and that bit at a multiple
+//    of log2(k): (n & (n-1)) == 0 && (n & MASK) != 0, e.g. MASK = 0x55555555
+//    for k = 4
+//  - k prime:           n > 0 and n divides the largest power of k that fits
+//    in an int (the only divisors of k^e are powers of k)
+//  - any other k:       a perfect hash of the at most 20 powers of k into a
+//    64-slot table, with the multiplier searched for by the compiler:
+//    table[(n * MULT) >> 26] == n
+//
+// All three are constexpr, so PowerOf<3>::test(1162261467) can appear in a
+// static_assert. classify() runs a whole int array: with -mavx2 it does 8 ints
+// per step (bit tricks, or the hash with a gather for non-power-of-two k) and
+// writes one bit per element.
+//
+// Build: g++ -O2 -mavx2 14_power_of_k_constexpr.cpp
+//      Usage: ./a.out [count]
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+#include <chrono>
+#include <random>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+constexpr bool is_prime_u32(uint32_t k)
+{
+    if (k < 2)
+        return false;
+    for (uint32_t d = 2; d * d <= k; d++)
+        if (k % d == 0)
+            return false;
+    return true;
+}
+
+template <uint32_t K>
+class PowerOf {
+    static_assert(K >= 2, "base must be at least 2");
+
+public:
+    enum Kind { BITS, PRIME, HASH };
+    static constexpr Kind kind = (K & (K - 1)) == 0 ? BITS : is_prime_u32(K) ? PRIME : HASH;
+
+    static constexpr bool test(int n)
+    {
+        if (n <= 0)
+            return false;
+        uint32_t u = (uint32_t)n;
+        if (kind == BITS)
+            return (u & (u - 1)) == 0 && (u & BIT_MASK) != 0;
+        if (kind == PRIME)
+            return MAX_POWER % u == 0;
+        return TABLE.slot[hash(u)] == n;
+    }
+
+    // bits[i / 64] bit i%64 = test(a[i]); bits must hold (count + 63) / 64 words.
+    static void classify(const int *a, size_t count, uint64_t *bits)
+    {
+        for (size_t w = 0; w < (count + 63) / 64; w++)
+            bits[w] = 0;
+        size_t i = 0;
+#ifdef __AVX2__
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 8 <= count; i += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+            __m256i hit;
+            if (kind == BITS) {
+                __m256i single = _mm256_cmpeq_epi32(_mm256_and_si256(x, _mm256_sub_epi32(x, _mm256_set1_epi32(1))), zero);
+                __m256i in_mask = _mm256_cmpeq_epi32(_mm256_and_si256(x, _mm256_set1_epi32((int)BIT_MASK)), zero);
+                hit = _mm256_andnot_si256(in_mask, single);
+            } else {
+                // prime bases use the hash here too: there is no vector division
+                __m256i h = _mm256_srli_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32((int)TABLE.mult)), 32 - HASH_BITS);
+                hit = _mm256_cmpeq_epi32(_mm256_i32gather_epi32(TABLE.slot, h, 4), x);
+            }
+            hit = _mm256_and_si256(hit, _mm256_cmpgt_epi32(x, zero));
+            uint64_t m = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(hit));
+            bits[i / 64] |= m << (i % 64);
+        }
+#endif
+        for (; i < count; i++)
+            if (test(a[i]))
+                bits[i / 64] |= 1ull << (i % 64);
+    }
+
+    // Largest power of K that fits in an int.
+    static constexpr int32_t max_power() { return MAX_POWER; }
+
+private:
+    static constexpr int HASH_BITS = 6;
+
+    struct Table {
+        uint32_t mult;
+        int32_t slot[1 << HASH_BITS];
+    };
+
+    static constexpr int32_t compute_max_power()
+    {
+        int64_t p = 1;
+        while (p * K <= INT32_MAX)
+            p *= K;
+        return (int32_t)p;
+    }
+
+    // bits at every multiple of log2(K): the exponents K^e can land on
+    static constexpr uint32_t compute_bit_mask()
+    {
+        if ((K & (K - 1)) != 0)
+            return 0;
+        int step = 0;
+        while ((1u << step) != K)
+            step++;
+        uint32_t mask = 0;
+        for (int b = 0; b < 31; b += step)
+            mask |= 1u << b;
+        return mask;
+    }
+
+    static constexpr uint32_t hash_with(uint32_t u, uint32_t mult) { return (u * mult) >> (32 - HASH_BITS); }
+
+    // Tries odd multipliers from a Weyl sequence until all powers of K land
+    // in distinct slots; empty slots hold 0, which no positive n can match.
+    static constexpr Table compute_table()
+    {
+        Table t{};
+        if ((K & (K - 1)) == 0)
+            return t;
+        uint32_t mult = 0x9E3779B1u;
+        for (int attempt = 0; attempt < 1000000; attempt++, mult += 0x6A09E668u) {
+            Table c{};
+            c.mult = mult | 1;
+            bool clash = false;
+            for (int64_t p = 1; p <= INT32_MAX && !clash; p *= K) {
+                uint32_t h = hash_with((uint32_t)p, c.mult);
+                if (c.slot[h] != 0)
+                    clash = true;
+                c.slot[h] = (int32_t)p;
+            }
+            if (!clash)
+                return c;
+        }
+        return t;
+    }
+
+    static constexpr uint32_t hash(uint32_t u) { return hash_with(u, TABLE.mult); }
+
+    static constexpr int32_t MAX_POWER = compute_max_power();
+    static constexpr uint32_t BIT_MASK = compute_bit_mask();
+    static constexpr Table TABLE = compute_table();
+};
+
+// Evaluated by the compiler: a wrong table or mask fails the build.
+static_assert(PowerOf<2>::test(1 << 30) && !PowerOf<2>::test(0) && !PowerOf<2>::test(INT_MIN), "");
+static_assert(PowerOf<4>::test(1 << 30) && !PowerOf<4>::test(1 << 29), "");
+static_assert(PowerOf<3>::test(1162261467) && !PowerOf<3>::test(1162261466), "");
+static_assert(PowerOf<6>::test(60466176) && !PowerOf<6>::test(36 * 5), "");
+static_assert(PowerOf<10>::test(1000000000) && !PowerOf<10>::test(0), "");
+
+class Solution {
+public:
+    bool isPowerOfTwo(int n) { return PowerOf<2>::test(n); }
+    bool isPowerOfThree(int n) { return PowerOf<3>::test(n); }
+    bool isPowerOfFour(int n) { return PowerOf<4>::test(n); }
+};
+
+// The loops from 04-06, for one base k.
+static bool power_loop(int n, int k)
+{
+    if (n <= 0)
+        return false;
+    while (n % k == 0)
+        n /= k;
+    return n == 1;
+}
+
+static double seconds_since(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+template <uint32_t K>
+static void check_and_time(const vector<int> &a)
+{
+    size_t n = a.size();
+    vector<uint64_t> bits((n + 63) / 64);
+
+    // agreement on the test data and on every power of K and its neighbours
+    size_t bad = 0;
+    for (int x : a)
+        bad += PowerOf<K>::test(x) != power_loop(x, (int)K);
+    for (int64_t p = 1; p <= INT32_MAX; p *= K)
+        for (int64_t d = -1; d <= 1; d++)
+            if (p + d <= INT32_MAX)
+                bad += PowerOf<K>::test((int)(p + d)) != power_loop((int)(p + d), (int)K);
+    PowerOf<K>::classify(a.data(), n, bits.data());
+    for (size_t i = 0; i < n; i++)
+        bad += (bool)((bits[i / 64] >> (i % 64)) & 1) != power_loop(a[i], (int)K);
+
+    auto t0 = chrono::steady_clock::now();
+    size_t hits_loop = 0;
+    for (int x : a)
+        hits_loop += power_loop(x, (int)K);
+    double tl = seconds_since(t0);
+    t0 = chrono::steady_clock::now();
+    size_t hits_test = 0;
+    for (int x : a)
+        hits_test += PowerOf<K>::test(x);
+    double tt = seconds_since(t0);
+    t0 = chrono::steady_clock::now();
+    PowerOf<K>::classify(a.data(), n, bits.data());
+    double tc = seconds_since(t0);
+    size_t hits_batch = 0;
+    for (uint64_t w : bits)
+        hits_batch += (size_t)__builtin_popcountll(w);
+
+    static const char *kinds[] = {"bits", "prime", "hash"};
+    cout << "k = " << K << " (" << kinds[PowerOf<K>::kind] << "): " << hits_loop << "/" << hits_test
+         << "/" << hits_batch << " hits, loop " << tl << " s, test " << tt << " s, classify " << tc
+         << " s, " << bad << " mismatches\n";
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : (1 << 24);
+
+    // Mostly small numbers (where the loops are cheap), one in eight a power.
+    mt19937 rng(11);
+    vector<int> a(count);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t r = rng();
+        if (r % 8 == 0) {
+            int k = 2 + (int)(r >> 8) % 9;
+            int64_t p = 1;
+            for (int e = (int)(r >> 16) % 31; e > 0 && p * k <= INT32_MAX; e--)
+                p *= k;
+            a[i] = (int)p;
+        } else if (r % 8 == 1) {
+            a[i] = -(int)(r >> 4);
+        } else {
+            a[i] = (int)(r >> (r % 24));
+        }
+    }
+
+    Solution ob;
+    cout << "isPowerOfTwo(1024) = " << ob.isPowerOfTwo(1024) << ", isPowerOfThree(243) = "
+         << ob.isPowerOfThree(243) << ", isPowerOfFour(32) = " << ob.isPowerOfFour(32) << "\n\n";
+
+    cout << count << " ints, hits shown as loop/test/classify\n";
+    check_and_time<2>(a);
+    check_and_time<3>(a);
+    check_and_time<4>(a);
+    check_and_time<5>(a);
+    check_and_time<6>(a);
+    check_and_time<10>(a);
+    check_and_time<12>(a);
+    check_and_time<7>(a);
+    return 0;
+}
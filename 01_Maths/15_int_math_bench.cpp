@@ -0,0 +1,184 @@
+// Microbenchmarks and exactness checks for int_math.h against the loop and
+// floating-point versions used across 01_Maths and 03_recursion:
+//
+//   ilog2   vs  shift loop (decimalToBinary's one step per bit)
+//   ilog10  vs  divide-by-10 loop and floor(log10(double))
+//   ilogk   vs  divide-by-k loop (the 04-06 power-of-k pattern)
+//   isqrt   vs  (uint64_t)sqrt(double) (exactly3Divisors' i <= sqrt(N))
+//   icbrt   vs  (uint64_t)cbrt(double)
+//   popcount_batch (dispatched) vs Kernighan's clear-lowest-bit loop
+//   checked_mul vs a division-based overflow check
+//
+// Build: g++ -O2 15_int_math_bench.cpp   (no -m flags: the batch functions pick
+// LZCNT/POPCNT at run time)
+//      Usage: ./a.out [count]
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "int_math.h"
+
+using namespace std;
+using namespace int_math;
+
+static double seconds_since(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+static volatile uint64_t sink;     // keeps the benchmarked loops alive
+
+// Runs fn over xs, returns (checksum, seconds).
+template <class F>
+static pair<uint64_t, double> bench(const vector<uint64_t> &xs, F fn)
+{
+    auto t0 = chrono::steady_clock::now();
+    uint64_t sum = 0;
+    for (uint64_t x : xs)
+        sum += (uint64_t)fn(x);
+    sink = sum;
+    return {sum, seconds_since(t0)};
+}
+
+// Number of values in xs and edges where the reference and int_math disagree.
+template <class F, class G>
+static size_t differences(const vector<uint64_t> &xs, const vector<uint64_t> &edges, F ref, G fast)
+{
+    size_t d = 0;
+    for (uint64_t x : xs)
+        d += (uint64_t)ref(x) != (uint64_t)fast(x);
+    for (uint64_t x : edges)
+        d += (uint64_t)ref(x) != (uint64_t)fast(x);
+    return d;
+}
+
+static void report(const char *name, pair<uint64_t, double> loop, pair<uint64_t, double> fast, size_t wrong)
+{
+    cout << name << ": reference " << loop.second << " s, int_math " << fast.second << " s ("
+         << loop.second / fast.second << "x), disagree on " << wrong << " values\n";
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    const CpuFeatures &f = cpu();
+    cout << "cpu: popcnt " << f.popcnt << ", lzcnt " << f.lzcnt << "; batch kernels: " << batch_kernels()
+         << "\n\n";
+
+    // Values spread over all magnitudes, plus the boundaries where floating
+    // point goes wrong: powers of 10, perfect squares and cubes, and +-1.
+    mt19937_64 rng(5);
+    vector<uint64_t> xs(count);
+    for (auto &x : xs)
+        x = (rng() >> (rng() % 64)) | 1;
+    vector<uint64_t> edges;
+    for (uint64_t p = 1; p <= 1000000000000000000ull; p *= 10)
+        edges.insert(edges.end(), {p - 1 ? p - 1 : 1, p, p + 1});
+    for (uint64_t r = 1; r < (1ull << 32); r = r * 3 + 1)
+        edges.insert(edges.end(), {r * r - 1 ? r * r - 1 : 1, r * r, r * r + 1});
+    for (uint64_t r = 4294967000ull; r <= 4294967295ull; r++)
+        edges.insert(edges.end(), {r * r - 1, r * r, r * r + 1});
+    for (uint64_t r = 2642000; r <= 2642245; r++)
+        edges.insert(edges.end(), {r * r * r - 1, r * r * r, r * r * r + 1});
+    edges.insert(edges.end(), {~0ull, ~0ull - 1, 1ull << 63});
+
+    // exactness on the edge values, brute-force definitions
+    size_t bad = 0;
+    for (uint64_t x : edges) {
+        uint64_t s = isqrt(x), c = icbrt(x);
+        bad += (unsigned __int128)s * s > x || (unsigned __int128)(s + 1) * (s + 1) <= x;
+        bad += (unsigned __int128)c * c * c > x || (unsigned __int128)(c + 1) * (c + 1) * (c + 1) <= x;
+        int d = 0;
+        for (uint64_t y = x; y >= 10; y /= 10)
+            d++;
+        bad += ilog10(x) != d;
+        for (uint64_t k : {2ull, 3ull, 4ull, 7ull, 10ull, 16ull, 1000ull}) {
+            int e = 0;
+            for (uint64_t y = x; y >= k; y /= k)
+                e++;
+            bad += ilogk(x, k) != e;
+        }
+    }
+    cout << edges.size() << " boundary values: " << bad << " wrong results from int_math\n\n";
+
+    auto loop_log2 = [](uint64_t x) { int e = 0; while (x >>= 1) e++; return e; };
+    auto fast_log2 = [](uint64_t x) { return ilog2(x); };
+    auto r1 = bench(xs, loop_log2), r2 = bench(xs, fast_log2);
+    report("ilog2 ", r1, r2, differences(xs, edges, loop_log2, fast_log2));
+
+    vector<int> out(count);
+    auto t0 = chrono::steady_clock::now();
+    ilog2_batch(xs.data(), count, out.data());
+    double tb = seconds_since(t0);
+    size_t diff = 0;
+    for (size_t i = 0; i < count; i++)
+        diff += out[i] != loop_log2(xs[i]);
+    cout << "ilog2_batch: " << tb << " s, " << diff << " differences from the shift loop\n";
+
+    auto loop_log10 = [](uint64_t x) { int e = 0; while (x >= 10) { x /= 10; e++; } return e; };
+    auto fast_log10 = [](uint64_t x) { return ilog10(x); };
+    r1 = bench(xs, loop_log10);
+    r2 = bench(xs, fast_log10);
+    report("ilog10", r1, r2, differences(xs, edges, loop_log10, fast_log10));
+    size_t wrong = 0;
+    for (uint64_t x : edges)
+        wrong += (int)floor(log10((double)x)) != loop_log10(x);
+    cout << "floor(log10(double)) on the boundary values: " << wrong << " wrong\n";
+    t0 = chrono::steady_clock::now();
+    ilog10_batch(xs.data(), count, out.data());
+    tb = seconds_since(t0);
+    diff = 0;
+    for (size_t i = 0; i < count; i++)
+        diff += out[i] != loop_log10(xs[i]);
+    cout << "ilog10_batch: " << tb << " s, " << diff << " differences from the divide loop\n";
+
+    auto loop_log3 = [](uint64_t x) { int e = 0; while (x >= 3) { x /= 3; e++; } return e; };
+    auto fast_log3 = [](uint64_t x) { return ilogk(x, 3); };
+    r1 = bench(xs, loop_log3);
+    r2 = bench(xs, fast_log3);
+    report("ilogk(3)", r1, r2, differences(xs, edges, loop_log3, fast_log3));
+
+    auto fp_sqrt = [](uint64_t x) { return (uint64_t)sqrt((double)x); };
+    wrong = 0;
+    for (uint64_t x : edges)
+        wrong += fp_sqrt(x) != isqrt(x);
+    r1 = bench(xs, fp_sqrt);
+    r2 = bench(xs, [](uint64_t x) { return isqrt(x); });
+    report("isqrt ", r1, r2, wrong);
+
+    auto fp_cbrt = [](uint64_t x) { return (uint64_t)cbrt((double)x); };
+    wrong = 0;
+    for (uint64_t x : edges)
+        wrong += fp_cbrt(x) != icbrt(x);
+    r1 = bench(xs, fp_cbrt);
+    r2 = bench(xs, [](uint64_t x) { return icbrt(x); });
+    report("icbrt ", r1, r2, wrong);
+
+    auto kernighan = [](uint64_t x) { int c = 0; while (x) { x &= x - 1; c++; } return c; };
+    r1 = bench(xs, kernighan);
+    t0 = chrono::steady_clock::now();
+    uint64_t pc = popcount_batch(xs.data(), count);
+    double tp = seconds_since(t0);
+    cout << "popcount: Kernighan " << r1.second << " s, popcount_batch " << tp << " s, totals "
+         << (r1.first == pc ? "agree" : "DIFFER") << "\n";
+
+    // checked multiply of neighbouring pairs
+    auto t1 = chrono::steady_clock::now();
+    size_t over_div = 0;
+    for (size_t i = 1; i < count; i++) {
+        uint64_t a = xs[i - 1], b = xs[i];
+        over_div += a != 0 && b > UINT64_MAX / a;
+    }
+    double td = seconds_since(t1);
+    t1 = chrono::steady_clock::now();
+    size_t over_chk = 0;
+    for (size_t i = 1; i < count; i++) {
+        uint64_t p;
+        over_chk += !checked_mul(xs[i - 1], xs[i], p);
+    }
+    double tc = seconds_since(t1);
+    cout << "checked_mul: division check " << td << " s, builtin " << tc << " s, overflows "
+         << over_div << "/" << over_chk << "\n";
+    return 0;
+}
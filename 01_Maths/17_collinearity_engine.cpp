@@ -0,0 +1,403 @@
+// Collinearity tests for 64-bit coordinates, generalising pass_origin in
+// 07_origin_pass. pass_origin compares Y1 * X2 == Y2 * X1 in int, which
+// overflows once the coordinates pass about 46341.
+//
+//  - orientation of three points: the sign of (b - a) x (c - a). Differences
+//    of int64 values need 65 bits and their products 130, so each product is
+//    kept as a sign and an unsigned 128-bit magnitude; the comparison is exact
+//    for every int64 input
+//  - batch tests: which lines pass through the origin, which points lie on a
+//    given line, whether a whole set is collinear
+//  - grouping by slope: each point's direction from an anchor is reduced by
+//    the gcd to (dx/g, dy/g) with a canonical sign. Threads compute the keys
+//    for their index range and count them per hash shard; a prefix sum then
+//    lets each thread scatter its indices straight into the shards, and each
+//    thread sorts one shard and cuts it into groups. Groups are ranges of one
+//    flat index array, so there is no allocation per group
+//
+//      Usage: ./a.out [points] [threads]
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include "column_codec.h"
+using namespace std;
+using column_codec::decodeColumn;
+
+typedef unsigned __int128 u128;
+
+struct Point {
+    int64_t x, y;
+};
+
+// a * b as sign and magnitude; |a|, |b| < 2^64 so the magnitude fits in 128 bits
+struct Product {
+    int sign;       // -1, 0, 1
+    u128 mag;
+};
+
+// v as sign and magnitude, for v the difference of two int64 values
+static inline void split(__int128 v, int& sign, uint64_t& mag) {
+    sign = (v > 0) - (v < 0);
+    mag = (uint64_t)(v < 0 ? -v : v);
+}
+
+static inline Product multiply(__int128 a, __int128 b) {
+    int sa, sb;
+    uint64_t ma, mb;
+    split(a, sa, ma);
+    split(b, sb, mb);
+    return Product{sa * sb, (u128)ma * mb};
+}
+
+// sign of p - q
+static inline int compare(const Product& p, const Product& q) {
+    if (p.sign != q.sign)
+        return p.sign < q.sign ? -1 : 1;
+    if (p.mag == q.mag)
+        return 0;
+    int bigger = p.mag > q.mag ? 1 : -1;
+    return p.sign >= 0 ? bigger : -bigger;
+}
+
+// Function to find the orientation of a, b, c: 1 counter-clockwise, -1
+// clockwise, 0 collinear
+int orientation(Point a, Point b, Point c) {
+    __int128 dx1 = (__int128)b.x - a.x, dy1 = (__int128)b.y - a.y;
+    __int128 dx2 = (__int128)c.x - a.x, dy2 = (__int128)c.y - a.y;
+    return compare(multiply(dx1, dy2), multiply(dy1, dx2));
+}
+
+bool collinear(Point a, Point b, Point c) {
+    return orientation(a, b, c) == 0;
+}
+
+// Function to check if the line through p and q passes through the origin.
+// The products of two int64 values fit in __int128 directly.
+bool passesOrigin(Point p, Point q) {
+    return (__int128)p.y * q.x == (__int128)q.y * p.x;
+}
+
+// ---------------------------------------------------------------------------
+// Batch tests
+// ---------------------------------------------------------------------------
+
+struct Line {
+    Point p, q;
+};
+
+void passesOriginBatch(const Line* lines, size_t count, bool* out) {
+    for (size_t i = 0; i < count; i++)
+        out[i] = passesOrigin(lines[i].p, lines[i].q);
+}
+
+// out[i] = points[i] lies on the line through a and b (a != b)
+void onLineBatch(Point a, Point b, const Point* points, size_t count, bool* out) {
+    for (size_t i = 0; i < count; i++)
+        out[i] = collinear(a, b, points[i]);
+}
+
+bool allCollinear(const Point* points, size_t count) {
+    size_t j = 1;
+    while (j < count && points[j].x == points[0].x && points[j].y == points[0].y)
+        j++;                                    // need two distinct points first
+    for (size_t i = j + 1; i < count; i++)
+        if (!collinear(points[0], points[j], points[i]))
+            return false;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Grouping by reduced slope
+// ---------------------------------------------------------------------------
+
+// Direction from the anchor with the gcd divided out and a canonical sign:
+// dx > 0, or dx == 0 and dy > 0. (0, 0) marks a point equal to the anchor.
+struct Slope {
+    uint64_t dx, dy;
+    bool dy_negative;
+
+    bool operator==(const Slope& o) const { return dx == o.dx && dy == o.dy && dy_negative == o.dy_negative; }
+};
+
+struct SlopeHash {
+    size_t operator()(const Slope& s) const {
+        uint64_t h = s.dx * 0x9E3779B97F4A7C15ull ^ (s.dy + (s.dy_negative ? 0x632BE59BD9B4E019ull : 0));
+        h ^= h >> 31;
+        h *= 0xBF58476D1CE4E5B9ull;
+        return (size_t)(h ^ (h >> 29));
+    }
+};
+
+static uint64_t gcd64(uint64_t a, uint64_t b) {
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+    int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b != 0) {
+        b >>= __builtin_ctzll(b);
+        if (a > b)
+            swap(a, b);
+        b -= a;
+    }
+    return a << shift;
+}
+
+static Slope reduced_slope(Point anchor, Point p) {
+    __int128 dx = (__int128)p.x - anchor.x, dy = (__int128)p.y - anchor.y;
+    if (dx < 0 || (dx == 0 && dy < 0)) {
+        dx = -dx;
+        dy = -dy;
+    }
+    uint64_t mx = (uint64_t)dx, my = (uint64_t)(dy < 0 ? -dy : dy);
+    uint64_t g = gcd64(mx, my);
+    if (g == 0)
+        return Slope{0, 0, false};
+    return Slope{mx / g, my / g, dy < 0};
+}
+
+// Groups as one flat index array: group k is
+// members[groups[k].begin .. groups[k].begin + groups[k].size).
+struct SlopeGroups {
+    struct Group {
+        uint32_t begin, size;
+    };
+    vector<uint32_t> members;           // point indices, each group contiguous and ascending
+    vector<Group> groups;               // largest first
+    vector<uint32_t> same_as_anchor;    // indices of points equal to the anchor
+};
+
+// Function to group points by their direction from anchor, on `threads` threads
+SlopeGroups groupBySlope(Point anchor, const Point* points, size_t count, unsigned threads) {
+    if (threads == 0)
+        threads = 1;
+    // Buckets 0..threads-1 are hash shards; bucket `threads` holds the points
+    // equal to the anchor.
+    const unsigned buckets = threads + 1;
+    struct Entry {
+        uint64_t dx, dy;
+        uint32_t negative, index;
+        bool operator<(const Entry& o) const {
+            if (dx != o.dx)
+                return dx < o.dx;
+            if (dy != o.dy)
+                return dy < o.dy;
+            if (negative != o.negative)
+                return negative < o.negative;
+            return index < o.index;
+        }
+    };
+    vector<Slope> keys(count);
+    vector<uint32_t> bucket(count);
+    vector<size_t> counts((size_t)threads * buckets);     // counts[t * buckets + b]
+    size_t chunk = (count + threads - 1) / threads;
+    auto run = [threads](auto&& body) {
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++)
+            pool.emplace_back(body, t);
+        for (auto& th : pool)
+            th.join();
+    };
+
+    // phase 1: keys and buckets, split by index range, with per-thread counts
+    run([&](unsigned t) {
+        size_t lo = min(count, t * chunk), hi = min(count, lo + chunk);
+        SlopeHash h;
+        size_t* c = &counts[(size_t)t * buckets];
+        for (size_t i = lo; i < hi; i++) {
+            Slope k = reduced_slope(anchor, points[i]);
+            keys[i] = k;
+            uint32_t b = k.dx == 0 && k.dy == 0 ? threads : (uint32_t)((h(k) >> 32) % threads);
+            bucket[i] = b;
+            c[b]++;
+        }
+    });
+
+    // prefix sum, bucket-major, so bucket b's entries are contiguous and each
+    // thread's share within it follows the previous thread's (indices ascend)
+    vector<size_t> bucket_begin(buckets + 1);
+    size_t pos = 0;
+    for (unsigned b = 0; b < buckets; b++) {
+        bucket_begin[b] = pos;
+        for (unsigned t = 0; t < threads; t++) {
+            size_t n = counts[(size_t)t * buckets + b];
+            counts[(size_t)t * buckets + b] = pos;
+            pos += n;
+        }
+    }
+    bucket_begin[buckets] = pos;
+
+    // scatter each index into its bucket
+    vector<Entry> entries(count);
+    run([&](unsigned t) {
+        size_t lo = min(count, t * chunk), hi = min(count, lo + chunk);
+        size_t* next = &counts[(size_t)t * buckets];
+        for (size_t i = lo; i < hi; i++) {
+            const Slope& k = keys[i];
+            entries[next[bucket[i]]++] = Entry{k.dx, k.dy, k.dy_negative, (uint32_t)i};
+        }
+    });
+
+    // phase 2: thread t sorts shard t by key and cuts it into runs of equal keys
+    SlopeGroups r;
+    r.members.resize(bucket_begin[threads]);
+    vector<vector<SlopeGroups::Group>> part(threads);
+    run([&](unsigned t) {
+        size_t lo = bucket_begin[t], hi = bucket_begin[t + 1];
+        sort(entries.begin() + lo, entries.begin() + hi);
+        for (size_t i = lo; i < hi;) {
+            size_t j = i;
+            while (j < hi && entries[j].dx == entries[i].dx && entries[j].dy == entries[i].dy &&
+                   entries[j].negative == entries[i].negative) {
+                r.members[j] = entries[j].index;
+                j++;
+            }
+            part[t].push_back(SlopeGroups::Group{(uint32_t)i, (uint32_t)(j - i)});
+            i = j;
+        }
+    });
+
+    for (size_t i = bucket_begin[threads]; i < count; i++)
+        r.same_as_anchor.push_back(entries[i].index);
+    size_t total = 0;
+    for (auto& g : part)
+        total += g.size();
+    r.groups.reserve(total);
+    for (auto& g : part)
+        r.groups.insert(r.groups.end(), g.begin(), g.end());
+    sort(r.groups.begin(), r.groups.end(), [](const SlopeGroups::Group& a, const SlopeGroups::Group& b) {
+        return a.size != b.size ? a.size > b.size : a.begin < b.begin;
+    });
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// pass_origin with spreadsheet-style Y labels, as in 07_origin_pass (decoded
+// with column_codec.h)
+// ---------------------------------------------------------------------------
+
+// Function to check if the line passes through the origin; labels past
+// INT64_MAX are rejected
+bool pass_origin(int64_t X1, string_view Y1, int64_t X2, string_view Y2) {
+    uint64_t y1, y2;
+    if (!decodeColumn(Y1, y1) || !decodeColumn(Y2, y2) || y1 > INT64_MAX || y2 > INT64_MAX)
+        return false;
+    return passesOrigin(Point{X1, (int64_t)y1}, Point{X2, (int64_t)y2});
+}
+
+// The original int comparison, for the overflow demonstration (in unsigned
+// arithmetic so the wrap-around is defined)
+static bool pass_origin_int(int X1, int Y1, int X2, int Y2) {
+    return (int)((unsigned)Y1 * (unsigned)X2) == (int)((unsigned)Y2 * (unsigned)X1);
+}
+
+static double seconds_since(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+    if (count == 0 || count > UINT32_MAX) {
+        cerr << "points must be between 1 and 2^32 - 1\n";
+        return 1;
+    }
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    if (argc > 2) {
+        char* end;
+        long t = strtol(argv[2], &end, 10);
+        if (*end != '\0' || t < 1 || t > 1024) {
+            cerr << "threads must be between 1 and 1024\n";
+            return 1;
+        }
+        threads = (unsigned)t;
+    }
+
+    cout << "pass_origin(1, AA, 2, AB) = " << pass_origin(1, "AA", 2, "AB")
+         << ", pass_origin(1, A, 2, B) = " << pass_origin(1, "A", 2, "B") << "\n";
+
+    // int overflow in the original: 1 * 65536 and 65537 * 65536 agree modulo
+    // 2^32, so the vertical line x = 65536 "passes through the origin"
+    cout << "(65536, 1) and (65536, 65537) through origin: int " << pass_origin_int(65536, 1, 65536, 65537)
+         << ", exact " << passesOrigin({65536, 1}, {65536, 65537}) << "\n";
+
+    // Extreme coordinates: differences and products beyond int64 and __int128.
+    Point a{INT64_MIN, INT64_MIN}, b{INT64_MAX, INT64_MAX}, c{0, -1}, d{-1, -1};
+    cout << "diagonal through (INT64_MIN, INT64_MIN) and (INT64_MAX, INT64_MAX): (0, -1) "
+         << (collinear(a, b, c) ? "on" : "off") << ", (-1, -1) " << (collinear(a, b, d) ? "on" : "off") << "\n";
+
+    // Brute-force check on small random sets: grouping vs pairwise orientation.
+    mt19937_64 rng(17);
+    size_t bad = 0;
+    for (int trial = 0; trial < 200; trial++) {
+        vector<Point> pts(60);
+        for (auto& p : pts)
+            p = Point{(int64_t)(rng() % 9) - 4, (int64_t)(rng() % 9) - 4};
+        Point anchor{0, 0};
+        SlopeGroups g = groupBySlope(anchor, pts.data(), pts.size(), 1 + trial % 4);
+        vector<int> group_of(pts.size(), -1);
+        for (size_t k = 0; k < g.groups.size(); k++)
+            for (uint32_t m = 0; m < g.groups[k].size; m++)
+                group_of[g.members[g.groups[k].begin + m]] = (int)k;
+        for (size_t i = 0; i < pts.size(); i++) {
+            bool at_anchor = pts[i].x == 0 && pts[i].y == 0;
+            bad += at_anchor != (group_of[i] < 0);
+            for (size_t j = 0; j < pts.size() && !at_anchor; j++) {
+                if (pts[j].x == 0 && pts[j].y == 0)
+                    continue;
+                bool same_line = collinear(anchor, pts[i], pts[j]);
+                bad += same_line != (group_of[i] == group_of[j]);
+            }
+        }
+    }
+    cout << "grouping vs pairwise orientation, 200 random sets: " << bad << " mismatches\n";
+
+    // Batch throughput: planted lines through the anchor among random points.
+    vector<Point> pts(count);
+    for (size_t i = 0; i < count; i++) {
+        if (i % 4 == 0) {
+            int64_t k = (int64_t)(rng() % 2000000) - 1000000;
+            int64_t line = (int64_t)(i / 4 % 5);
+            pts[i] = Point{k * (line + 1), k * (3 - line * 7)};
+        } else {
+            pts[i] = Point{(int64_t)(rng() >> 2) - (1ll << 61), (int64_t)(rng() >> 2) - (1ll << 61)};
+        }
+    }
+    // i and i + 20 lie on the same planted line when i % 4 == 0
+    vector<Line> lines(count);
+    for (size_t i = 0; i < count; i++)
+        lines[i] = Line{pts[i], pts[(i + 20) % count]};
+    unique_ptr<bool[]> out(new bool[count]);
+
+    auto t0 = chrono::steady_clock::now();
+    passesOriginBatch(lines.data(), count, out.get());
+    double tp = seconds_since(t0);
+    size_t through = count_if(out.get(), out.get() + count, [](bool v) { return v; });
+    t0 = chrono::steady_clock::now();
+    onLineBatch(Point{0, 0}, Point{1, 3}, pts.data(), count, out.get());
+    double tl = seconds_since(t0);
+    size_t on_line = count_if(out.get(), out.get() + count, [](bool v) { return v; });
+
+    cout << "\n" << count << " points/lines:\n"
+         << "  passesOriginBatch " << tp << " s (" << through << " through the origin)\n"
+         << "  onLineBatch       " << tl << " s (" << on_line << " on y = 3x)\n";
+    for (unsigned t : {1u, threads}) {
+        t0 = chrono::steady_clock::now();
+        SlopeGroups g = groupBySlope(Point{0, 0}, pts.data(), count, t);
+        double tg = seconds_since(t0);
+        cout << "  groupBySlope, " << t << " thread(s): " << tg << " s, " << g.groups.size()
+             << " directions, largest " << (g.groups.empty() ? 0 : g.groups[0].size) << " points, "
+             << g.same_as_anchor.size() << " at the anchor\n";
+        if (t == threads)
+            break;
+    }
+    return 0;
+}
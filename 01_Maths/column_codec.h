@@ -0,0 +1,60 @@
+/*
+ * ======================================================================================
+ * column_codec.h: SPREADSHEET COLUMN LABELS AS BIJECTIVE BASE 26
+ * ======================================================================================
+ * A = 1, Z = 26, AA = 27, ... as used by convertExcelColumnToInt in 07_origin_pass.
+ * Scalar, allocation-free versions shared by 16_excel_column_codec.cpp (which adds
+ * the packed SSSE3 batch decoder) and 17_collinearity_engine.cpp:
+ *
+ *      decodeColumn(label, out)   false on empty input, a character outside 'A'..'Z',
+ *                                 or a value that does not fit in 64 bits
+ *      encodeColumn(n, buf)       n >= 1 into buf (at least 14 bytes), returns length
+ *      encodeColumn(n)            the same as a std::string
+ * ======================================================================================
+ */
+
+#ifndef COLUMN_CODEC_H
+#define COLUMN_CODEC_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace column_codec {
+
+inline bool decodeColumn(std::string_view label, uint64_t& out) {
+    if (label.empty())
+        return false;
+    uint64_t v = 0;
+    for (char c : label) {
+        if (c < 'A' || c > 'Z')
+            return false;
+        if (__builtin_mul_overflow(v, 26, &v) || __builtin_add_overflow(v, (uint64_t)(c - '@'), &v))
+            return false;
+    }
+    out = v;
+    return true;
+}
+
+inline size_t encodeColumn(uint64_t n, char* buf) {
+    char tmp[16];
+    size_t len = 0;
+    while (n > 0) {
+        n--;                                // bijective: digits are 1..26, not 0..25
+        tmp[len++] = (char)('A' + n % 26);
+        n /= 26;
+    }
+    for (size_t i = 0; i < len; i++)
+        buf[i] = tmp[len - 1 - i];
+    return len;
+}
+
+inline std::string encodeColumn(uint64_t n) {
+    char buf[16];
+    return std::string(buf, encodeColumn(n, buf));
+}
+
+}  // namespace column_codec
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * ======================================================================================
+ * int_math.h: INTEGER LOGS, ROOTS AND CHECKED ARITHMETIC
+ * ======================================================================================
+ * The files in 01_Maths each redo this with loops or floating point: 04-06 divide until
+ * n stops being a multiple of k, exactly3Divisors compares i <= sqrt(N) in double, and
+ * decimalToBinary recurses once per bit. Everything here is exact for all 64-bit input:
+ *
+ *      ilog2(x)     floor(log2 x), x > 0              one count-leading-zeros
+ *      ilog10(x)    floor(log10 x), x > 0             ilog2 * 1233 >> 12, one table fix-up
+ *      ilogk(x, k)  floor(log_k x), x > 0, k >= 2     multiply up, no division per step
+ *      isqrt(x)     floor(sqrt x)                     double estimate, integer correction
+ *      icbrt(x)     floor(cbrt x)                     same
+ *      checked_add / checked_mul                      false on overflow, any integer type
+ *
+ * The single-value functions are inline and use the compiler builtins, which become
+ * BSR/LZCNT/POPCNT according to the -m flags the file is built with. Batch functions
+ * (ilog2_batch, ilog10_batch, popcount_batch) go one step further: they are compiled
+ * twice, once plain and once with target("lzcnt,popcnt"), and the first call
+ * picks one from CPUID. The check costs one indirect call per batch, not per value;
+ * dispatching single values that way would cost more than the instruction saves.
+ * ======================================================================================
+ */
+
+#ifndef INT_MATH_H
+#define INT_MATH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace int_math {
+
+inline int ilog2(uint64_t x) { return 63 - __builtin_clzll(x); }
+
+inline int ilog10(uint64_t x) {
+    static const uint64_t pow10[20] = {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+        100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+        10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+        100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull};
+    // 1233 / 4096 is just above log10(2), so t is floor(log10 x) or one more
+    int t = ((ilog2(x) + 1) * 1233) >> 12;
+    return t - (x < pow10[t]);
+}
+
+// k >= 2
+inline int ilogk(uint64_t x, uint64_t k) {
+    if ((k & (k - 1)) == 0)
+        return ilog2(x) / ilog2(k);
+    int e = 0;
+    uint64_t limit = x / k;             // p <= limit  <=>  p * k <= x, without overflow
+    for (uint64_t p = 1; p <= limit; p *= k)
+        e++;
+    return e;
+}
+
+inline uint64_t isqrt(uint64_t x) {
+    uint64_t r = (uint64_t)std::sqrt((double)x);
+    // the double estimate is off by at most one or two either way near 2^64
+    while (r > 0 && (r > 0xFFFFFFFFull || r * r > x))
+        r--;
+    while (r < 0xFFFFFFFFull && (r + 1) * (r + 1) <= x)
+        r++;
+    return r;
+}
+
+inline uint64_t icbrt(uint64_t x) {
+    uint64_t r = (uint64_t)std::cbrt((double)x);
+    // 2642245^3 is the largest cube below 2^64
+    while (r > 0 && (r > 2642245 || r * r * r > x))
+        r--;
+    while (r < 2642245 && (r + 1) * (r + 1) * (r + 1) <= x)
+        r++;
+    return r;
+}
+
+// out = a + b (checked_add) or a * b (checked_mul); false if that overflows T.
+template <class T>
+inline bool checked_add(T a, T b, T& out) { return !__builtin_add_overflow(a, b, &out); }
+
+template <class T>
+inline bool checked_mul(T a, T b, T& out) { return !__builtin_mul_overflow(a, b, &out); }
+
+// ---------------------------------------------------------------------------
+// CPU feature detection and dispatched batch functions
+// ---------------------------------------------------------------------------
+
+struct CpuFeatures {
+    bool popcnt = false, lzcnt = false;
+};
+
+inline CpuFeatures detect_cpu() {
+    CpuFeatures f;
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned a, b, c, d;
+    if (__get_cpuid(1, &a, &b, &c, &d))
+        f.popcnt = (c >> 23) & 1;
+    if (__get_cpuid(0x80000001, &a, &b, &c, &d))
+        f.lzcnt = (c >> 5) & 1;                 // ABM
+#endif
+    return f;
+}
+
+inline const CpuFeatures& cpu() {
+    static const CpuFeatures f = detect_cpu();
+    return f;
+}
+
+namespace detail {
+
+// Each kernel is written once as a macro body and instantiated per target.
+#define INT_MATH_KERNELS(SUFFIX)                                                            \
+    inline void ilog2_##SUFFIX(const uint64_t* x, size_t n, int* out) {                     \
+        for (size_t i = 0; i < n; i++)                                                      \
+            out[i] = 63 - __builtin_clzll(x[i]);                                            \
+    }                                                                                       \
+    inline void ilog10_##SUFFIX(const uint64_t* x, size_t n, int* out) {                    \
+        for (size_t i = 0; i < n; i++)                                                      \
+            out[i] = ilog10(x[i]);                                                          \
+    }                                                                                       \
+    inline uint64_t popcount_##SUFFIX(const uint64_t* x, size_t n) {                        \
+        uint64_t total = 0;                                                                 \
+        for (size_t i = 0; i < n; i++)                                                      \
+            total += (uint64_t)__builtin_popcountll(x[i]);                                  \
+        return total;                                                                       \
+    }
+
+INT_MATH_KERNELS(generic)
+
+#if defined(__x86_64__) || defined(__i386__)
+#pragma GCC push_options
+#pragma GCC target("lzcnt,popcnt")
+INT_MATH_KERNELS(native)
+#pragma GCC pop_options
+#define INT_MATH_HAVE_NATIVE 1
+#endif
+
+#undef INT_MATH_KERNELS
+
+struct Kernels {
+    void (*ilog2)(const uint64_t*, size_t, int*);
+    void (*ilog10)(const uint64_t*, size_t, int*);
+    uint64_t (*popcount)(const uint64_t*, size_t);
+    const char* name;
+};
+
+inline const Kernels& kernels() {
+    static const Kernels k = [] {
+#ifdef INT_MATH_HAVE_NATIVE
+        const CpuFeatures& f = cpu();
+        if (f.lzcnt && f.popcnt)
+            return Kernels{ilog2_native, ilog10_native, popcount_native, "lzcnt+popcnt"};
+#endif
+        return Kernels{ilog2_generic, ilog10_generic, popcount_generic, "generic"};
+    }();
+    return k;
+}
+
+}  // namespace detail
+
+// out[i] = ilog2(x[i]); every x[i] > 0.
+inline void ilog2_batch(const uint64_t* x, size_t n, int* out) { detail::kernels().ilog2(x, n, out); }
+
+// out[i] = ilog10(x[i]); every x[i] > 0.
+inline void ilog10_batch(const uint64_t* x, size_t n, int* out) { detail::kernels().ilog10(x, n, out); }
+
+// Total number of set bits in x[0..n).
+inline uint64_t popcount_batch(const uint64_t* x, size_t n) { return detail::kernels().popcount(x, n); }
+
+// Which kernel set the batch functions use on this CPU.
+inline const char* batch_kernels() { return detail::kernels().name; }
+
+}  // namespace int_math
+
+#endif
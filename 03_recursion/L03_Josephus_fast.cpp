@@ -0,0 +1,132 @@
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+using namespace std;
+
+// L02_Josephus.cpp recurses n deep, which overflows the stack for large n.
+// Three replacements (positions are 0-based, as in L02):
+//   josephusIterative  - same recurrence J(i) = (J(i-1) + k) % i, bottom-up, O(n)
+//   josephusFast       - O(k log n): removes every k-th person of a whole lap at once
+//   eliminationOrder   - the full order in which people leave, O(n log n), using a
+//                        Fenwick tree over a bitset instead of a linked circle
+
+int josephusIterative(int n, long long k) {
+    uint64_t r = 0;
+    for (int i = 2; i <= n; i++)
+        r = (r + (uint64_t)(k % i)) % i;
+    return (int)r;
+}
+
+// One lap over n people removes n/k of them. The survivor of the remaining
+// n - n/k people, counted from the last removed position, maps back to an index
+// in the original circle. Recursion depth is about k * ln(n).
+long long josephusFast(long long n, long long k) {
+    if (n == 1)
+        return 0;
+    if (k == 1)
+        return n - 1;
+    if (k > n)
+        return (josephusFast(n - 1, k) + k) % n;
+    long long removed = n / k;
+    long long res = josephusFast(n - removed, k) - n % k;
+    if (res < 0)
+        res += n;
+    else
+        res += res / (k - 1);
+    return res;
+}
+
+// Presence bitset (1 = still in the circle) with a Fenwick tree of per-word
+// counts on top. Memory is n/8 + n/16 bytes: about 19 MB for n = 10^8.
+class AliveSet {
+    vector<uint64_t> bits;
+    vector<uint32_t> tree;      // 1-based Fenwick tree over words
+    int words;
+    int top;                    // highest power of two <= words
+
+public:
+    explicit AliveSet(int n) : bits((n + 63) / 64, ~0ull), tree((n + 63) / 64 + 1, 0) {
+        words = (int)bits.size();
+        if (n % 64)
+            bits[words - 1] = (1ull << (n % 64)) - 1;
+        // O(words) Fenwick construction
+        for (int i = 1; i <= words; i++) {
+            tree[i] += (uint32_t)__builtin_popcountll(bits[i - 1]);
+            int parent = i + (i & -i);
+            if (parent <= words)
+                tree[parent] += tree[i];
+        }
+        top = 1;
+        while (top * 2 <= words)
+            top *= 2;
+    }
+
+    // Removes and returns the index of the r-th (0-based) remaining person.
+    int removeRank(uint32_t r) {
+        int pos = 0;
+        for (int step = top; step > 0; step >>= 1) {
+            if (pos + step <= words && tree[pos + step] <= r) {
+                pos += step;
+                r -= tree[pos];
+            }
+        }
+        // word pos holds the answer; drop the r lowest set bits
+        uint64_t w = bits[pos];
+        for (uint32_t i = 0; i < r; i++)
+            w &= w - 1;
+        int bit = __builtin_ctzll(w);
+        bits[pos] &= ~(1ull << bit);
+        for (int i = pos + 1; i <= words; i += i & -i)
+            tree[i]--;
+        return pos * 64 + bit;
+    }
+};
+
+// Calls emit(index) for each person in elimination order; the last one is
+// the survivor. Nothing proportional to n is stored besides the bitset.
+template <class F>
+void eliminationOrder(int n, long long k, F emit) {
+    AliveSet alive(n);
+    uint64_t rank = 0;
+    for (int remaining = n; remaining > 0; remaining--) {
+        rank = (rank + (uint64_t)((k - 1) % remaining)) % remaining;
+        emit(alive.removeRank((uint32_t)rank));
+    }
+}
+
+int main() {
+    int n;
+    long long k;
+    cout << "Enter number of people (n): ";
+    cin >> n;
+    cout << "Enter step size (k): ";
+    cin >> k;
+    if (n < 1 || k < 1) {
+        cout << "n and k must be positive" << endl;
+        return 0;
+    }
+
+    cout << "Survivor (iterative O(n)): " << josephusIterative(n, k) << endl;
+    if (k <= 1000)
+        cout << "Survivor (O(k log n)):     " << josephusFast(n, k) << endl;
+
+    auto t0 = chrono::steady_clock::now();
+    int shown = 0, last = -1;
+    uint64_t checksum = 0;
+    cout << "Elimination order: ";
+    eliminationOrder(n, k, [&](int idx) {
+        if (shown < 20) {
+            cout << idx << " ";
+            shown++;
+        }
+        checksum += (uint64_t)idx;
+        last = idx;
+    });
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if (n > 20)
+        cout << "...";
+    cout << "\nLast eliminated: " << last << " (order generated in " << secs << " s, sum "
+         << checksum << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,347 @@
+// CPP program to implement an LRU cache:
+// a hash map from key to node plus a doubly linked list in recency order.
+// get/put/evict are all O(1); the list head is the most recently used entry
+// and the tail is the next victim.
+//
+// Nodes come from a pool that hands out fixed-size slots carved from large
+// chunks and recycles evicted nodes. The key index is intrusive: each node
+// carries its own hash-chain link and the bucket array is sized once from the
+// capacity, so once the pool has grown to capacity, put() and evict() never
+// call malloc (main() counts operator new calls to check).
+//
+// ShardedLRUCache splits the key space over several independently locked
+// caches to cut lock contention between threads.
+#include <bits/stdc++.h>
+using namespace std;
+
+// Fixed-size object pool: allocates T slots in chunks and keeps freed slots
+// on an intrusive free list.
+template <class T, size_t CHUNK = 1024>
+class NodePool {
+	union Slot {
+		Slot *next;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+	vector<unique_ptr<Slot[]>> chunks;
+	Slot *free_list = nullptr;
+	size_t used_in_chunk = CHUNK;
+
+public:
+	template <class... Args>
+	T *create(Args &&...args)
+	{
+		Slot *s;
+		if (free_list != nullptr) {
+			s = free_list;
+			free_list = s->next;
+		}
+		else {
+			if (used_in_chunk == CHUNK) {
+				chunks.emplace_back(new Slot[CHUNK]);
+				used_in_chunk = 0;
+			}
+			s = &chunks.back()[used_in_chunk++];
+		}
+		return new (s->storage) T(std::forward<Args>(args)...);
+	}
+
+	void destroy(T *p)
+	{
+		p->~T();
+		Slot *s = reinterpret_cast<Slot *>(p);
+		s->next = free_list;
+		free_list = s;
+	}
+};
+
+struct CacheStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t evictions = 0;
+};
+
+template <class K, class V, class Hash = hash<K>>
+class LRUCache {
+	struct Node {
+		K key;
+		V value;
+		Node *prev;
+		Node *next;
+		Node *chain;	// next node in the same hash bucket
+		Node(const K &k, const V &v) : key(k), value(v), prev(nullptr), next(nullptr), chain(nullptr) {}
+	};
+
+	size_t cap;
+	size_t count = 0;
+	vector<Node *> buckets;	// power-of-two size >= capacity, never resized
+	size_t mask = 0;
+	Hash hasher;
+	NodePool<Node> pool;
+	Node *head = nullptr;	// most recently used
+	Node *tail = nullptr;	// least recently used
+	CacheStats st;
+
+	Node **bucket_for(const K &key)
+	{
+		uint64_t h = (uint64_t)hasher(key) * 0x9E3779B97F4A7C15ull;
+		return &buckets[(h >> 32) & mask];
+	}
+
+	Node *find(const K &key)
+	{
+		for (Node *n = *bucket_for(key); n; n = n->chain)
+			if (n->key == key)
+				return n;
+		return nullptr;
+	}
+
+	void index_insert(Node *n)
+	{
+		Node **b = bucket_for(n->key);
+		n->chain = *b;
+		*b = n;
+		count++;
+	}
+
+	void index_remove(Node *n)
+	{
+		Node **link = bucket_for(n->key);
+		while (*link != n)
+			link = &(*link)->chain;
+		*link = n->chain;
+		count--;
+	}
+
+	void unlink(Node *n)
+	{
+		if (n->prev)
+			n->prev->next = n->next;
+		else
+			head = n->next;
+		if (n->next)
+			n->next->prev = n->prev;
+		else
+			tail = n->prev;
+	}
+
+	void push_front(Node *n)
+	{
+		n->prev = nullptr;
+		n->next = head;
+		if (head)
+			head->prev = n;
+		else
+			tail = n;
+		head = n;
+	}
+
+	void evict()
+	{
+		Node *victim = tail;
+		unlink(victim);
+		index_remove(victim);
+		pool.destroy(victim);
+		st.evictions++;
+	}
+
+public:
+	explicit LRUCache(size_t capacity) : cap(capacity)
+	{
+		size_t n = 1;
+		while (n < capacity)
+			n *= 2;
+		buckets.assign(n, nullptr);
+		mask = n - 1;
+	}
+
+	~LRUCache()
+	{
+		while (head) {
+			Node *next = head->next;
+			pool.destroy(head);
+			head = next;
+		}
+	}
+
+	LRUCache(const LRUCache &) = delete;
+	LRUCache &operator=(const LRUCache &) = delete;
+
+	// Copies the value into out and marks the key as most recently used.
+	bool get(const K &key, V &out)
+	{
+		Node *n = find(key);
+		if (n == nullptr) {
+			st.misses++;
+			return false;
+		}
+		if (n != head) {
+			unlink(n);
+			push_front(n);
+		}
+		out = n->value;
+		st.hits++;
+		return true;
+	}
+
+	void put(const K &key, const V &value)
+	{
+		if (cap == 0)
+			return;
+		Node *n = find(key);
+		if (n != nullptr) {
+			n->value = value;
+			if (n != head) {
+				unlink(n);
+				push_front(n);
+			}
+			return;
+		}
+		if (count == cap)
+			evict();
+		n = pool.create(key, value);
+		push_front(n);
+		index_insert(n);
+	}
+
+	bool erase(const K &key)
+	{
+		Node *n = find(key);
+		if (n == nullptr)
+			return false;
+		unlink(n);
+		index_remove(n);
+		pool.destroy(n);
+		return true;
+	}
+
+	size_t size() const { return count; }
+	size_t capacity() const { return cap; }
+	CacheStats stats() const { return st; }
+};
+
+// SHARDS independent LRU caches, each behind its own mutex. A key always maps
+// to the same shard, so recency is tracked per shard rather than globally.
+template <class K, class V, size_t SHARDS = 16, class Hash = hash<K>>
+class ShardedLRUCache {
+	struct alignas(64) Shard {
+		mutex m;
+		LRUCache<K, V, Hash> cache;
+		explicit Shard(size_t cap) : cache(cap) {}
+	};
+	vector<unique_ptr<Shard>> shards;
+	Hash hasher;
+
+	Shard &shard_for(const K &key)
+	{
+		// mix the hash so identity hashes of small ints spread over shards
+		uint64_t h = (uint64_t)hasher(key) * 0x9E3779B97F4A7C15ull;
+		return *shards[(h >> 32) % SHARDS];
+	}
+
+public:
+	explicit ShardedLRUCache(size_t capacity)
+	{
+		size_t per_shard = (capacity + SHARDS - 1) / SHARDS;
+		for (size_t i = 0; i < SHARDS; i++)
+			shards.emplace_back(new Shard(per_shard));
+	}
+
+	bool get(const K &key, V &out)
+	{
+		Shard &s = shard_for(key);
+		lock_guard<mutex> lock(s.m);
+		return s.cache.get(key, out);
+	}
+
+	void put(const K &key, const V &value)
+	{
+		Shard &s = shard_for(key);
+		lock_guard<mutex> lock(s.m);
+		s.cache.put(key, value);
+	}
+
+	bool erase(const K &key)
+	{
+		Shard &s = shard_for(key);
+		lock_guard<mutex> lock(s.m);
+		return s.cache.erase(key);
+	}
+
+	CacheStats stats()
+	{
+		CacheStats total;
+		for (auto &s : shards) {
+			lock_guard<mutex> lock(s->m);
+			CacheStats c = s->cache.stats();
+			total.hits += c.hits;
+			total.misses += c.misses;
+			total.evictions += c.evictions;
+		}
+		return total;
+	}
+};
+
+// Counts every operator new, to check that a warm cache does not allocate.
+static atomic<size_t> g_allocs{0};
+
+void *operator new(size_t n)
+{
+	g_allocs.fetch_add(1, memory_order_relaxed);
+	if (void *p = malloc(n ? n : 1))
+		return p;
+	throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// Driver code
+int main()
+{
+	LRUCache<int, string> cache(2);
+	string v;
+	cache.put(1, "one");
+	cache.put(2, "two");
+	cache.get(1, v);		// 1 becomes most recent
+	cache.put(3, "three");	// evicts 2
+	cout << "get(2): " << (cache.get(2, v) ? v : "miss") << endl;
+	cout << "get(3): " << (cache.get(3, v) ? v : "miss") << endl;
+	CacheStats s = cache.stats();
+	cout << "hits " << s.hits << ", misses " << s.misses << ", evictions " << s.evictions << endl;
+
+	// Fill to capacity, then a million evicting puts and gets on a warm cache.
+	LRUCache<int, int> warm(1 << 16);
+	for (int i = 0; i < (1 << 16); i++)
+		warm.put(i, i);
+	size_t before = g_allocs.load();
+	int out = 0;
+	for (int i = 0; i < 1000000; i++) {
+		warm.put((1 << 16) + i, i);
+		warm.get(i * 7 % (1 << 17), out);
+	}
+	cout << "warm cache, 1000000 evicting puts: " << g_allocs.load() - before
+		 << " operator new calls, " << warm.stats().evictions << " evictions" << endl;
+
+	// Four threads hammering a sharded cache with a skewed key range.
+	ShardedLRUCache<int, int> shared(1 << 14);
+	vector<thread> workers;
+	auto t0 = chrono::steady_clock::now();
+	for (int t = 0; t < 4; t++) {
+		workers.emplace_back([&shared, t]() {
+			mt19937 rng(t);
+			int out;
+			for (int i = 0; i < 1000000; i++) {
+				int key = (int)(rng() % (1 << 15)) & (int)(rng() % (1 << 15));
+				if (!shared.get(key, out))
+					shared.put(key, key);
+			}
+		});
+	}
+	for (auto &w : workers)
+		w.join();
+	double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+	s = shared.stats();
+	cout << "sharded: hits " << s.hits << ", misses " << s.misses << ", evictions "
+		 << s.evictions << ", " << (4e6 / secs / 1e6) << " Mops/s" << endl;
+	return 0;
+}
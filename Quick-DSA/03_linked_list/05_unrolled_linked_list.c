@@ -0,0 +1,245 @@
+    /*
+     * Unrolled singly linked list.
+     *
+     * Each node (block) stores up to BLOCK_CAP ints in a small array, so a
+     * search walks one pointer per 16 values instead of one per value. When
+     * built with -mavx2 the search compares 8 ints per instruction; otherwise
+     * it falls back to a plain loop over the block.
+     *
+     * display() formats the whole list into one buffer and issues a single
+     * write() instead of one printf per node.
+     *
+     * Build: gcc -O2 -mavx2 05_unrolled_linked_list.c
+     */
+    #include<stdio.h>
+    #include<stdlib.h>
+    #include<string.h>
+    #include<unistd.h>
+    #ifdef __AVX2__
+    #include<immintrin.h>
+    #endif
+
+    #define BLOCK_CAP 16
+
+    struct block
+    {
+        int count;
+        struct block *next;
+        int data[BLOCK_CAP];
+    };
+    struct block *head, *tail;
+    long total;
+
+    void lastinsert();
+    void fill();
+    void search();
+    void display();
+    int append(int item);
+    long find(int item);
+    void main ()
+    {
+        int choice =0;
+        while(choice != 5)
+        {
+            printf("\n*********Main Menu*********\n");
+            printf("\nChoose one option from the following list ...\n");
+            printf("\n===============================================\n");
+            printf("\n1.Insert at last\n2.Insert 1..N at last\n3.Search for an element\n4.Show\n5.Exit\n");
+            printf("\nEnter your choice?\n");
+            scanf("\n%d",&choice);
+            switch(choice)
+            {
+                case 1:
+                lastinsert();
+                break;
+                case 2:
+                fill();
+                break;
+                case 3:
+                search();
+                break;
+                case 4:
+                display();
+                break;
+                case 5:
+                exit(0);
+                break;
+                default:
+                printf("Please enter valid choice..");
+            }
+        }
+    }
+
+    /* Appends item to the tail block, allocating a new block when it is full. */
+    int append(int item)
+    {
+        struct block *ptr;
+        if(tail == NULL || tail->count == BLOCK_CAP)
+        {
+            ptr = (struct block *)malloc(sizeof(struct block));
+            if(ptr == NULL)
+                return 0;
+            ptr->count = 0;
+            ptr->next = NULL;
+            if(tail == NULL)
+                head = ptr;
+            else
+                tail->next = ptr;
+            tail = ptr;
+        }
+        tail->data[tail->count++] = item;
+        total++;
+        return 1;
+    }
+
+    void lastinsert()
+    {
+        int item;
+        printf("\nEnter value?\n");
+        scanf("%d",&item);
+        if(!append(item))
+            printf("\nOVERFLOW");
+        else
+            printf("\nNode inserted");
+    }
+
+    void fill()
+    {
+        int n,i;
+        printf("\nEnter how many values?\n");
+        scanf("%d",&n);
+        for(i=1;i<=n;i++)
+        {
+            if(!append(i))
+            {
+                printf("\nOVERFLOW");
+                return;
+            }
+        }
+        printf("\n%d values inserted",n);
+    }
+
+    /* Returns the 0-based position of the first occurrence of item, or -1. */
+    long find(int item)
+    {
+        struct block *ptr;
+        long base = 0;
+        int i;
+    #ifdef __AVX2__
+        __m256i key = _mm256_set1_epi32(item);
+    #endif
+        for(ptr = head; ptr != NULL; ptr = ptr->next)
+        {
+            i = 0;
+    #ifdef __AVX2__
+            for(; i + 8 <= ptr->count; i += 8)
+            {
+                __m256i v = _mm256_loadu_si256((const __m256i *)(ptr->data + i));
+                int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, key)));
+                if(mask != 0)
+                    return base + i + __builtin_ctz(mask);
+            }
+    #endif
+            for(; i < ptr->count; i++)
+            {
+                if(ptr->data[i] == item)
+                    return base + i;
+            }
+            base += ptr->count;
+        }
+        return -1;
+    }
+
+    void search()
+    {
+        int item;
+        long loc;
+        if(head == NULL)
+        {
+            printf("\nEmpty List\n");
+            return;
+        }
+        printf("\nEnter item which you want to search?\n");
+        scanf("%d",&item);
+        loc = find(item);
+        if(loc < 0)
+            printf("\nItem not found\n");
+        else
+            printf("\nitem found at location %ld ",loc+1);
+    }
+
+    static const char digit_pairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    /* Writes val in decimal at out, two digits per step, and returns the end. */
+    static char *format_int(char *out, int val)
+    {
+        char tmp[12];
+        char *p = tmp + sizeof(tmp);
+        unsigned int u = val < 0 ? 0u - (unsigned int)val : (unsigned int)val;
+        size_t len;
+        while(u >= 100)
+        {
+            unsigned int r = u % 100;
+            u /= 100;
+            p -= 2;
+            memcpy(p, digit_pairs + 2 * r, 2);
+        }
+        if(u >= 10)
+        {
+            p -= 2;
+            memcpy(p, digit_pairs + 2 * u, 2);
+        }
+        else
+            *--p = (char)('0' + u);
+        if(val < 0)
+            *out++ = '-';
+        len = (size_t)(tmp + sizeof(tmp) - p);
+        memcpy(out, p, len);
+        return out + len;
+    }
+
+    void display()
+    {
+        static const char header[] = "\n printing values...\n";
+        struct block *ptr;
+        char *buf, *out;
+        size_t left;
+        ssize_t n;
+        int i;
+        /* at most 11 characters plus a newline per int */
+        buf = (char *)malloc(sizeof(header) + (size_t)total * 12);
+        if(buf == NULL)
+        {
+            printf("\nOVERFLOW");
+            return;
+        }
+        memcpy(buf, header, sizeof(header) - 1);
+        out = buf + sizeof(header) - 1;
+        for(ptr = head; ptr != NULL; ptr = ptr->next)
+        {
+            for(i = 0; i < ptr->count; i++)
+            {
+                out = format_int(out, ptr->data[i]);
+                *out++ = '\n';
+            }
+        }
+        fflush(stdout);
+        left = (size_t)(out - buf);
+        out = buf;
+        while(left > 0 && (n = write(STDOUT_FILENO, out, left)) > 0)
+        {
+            out += n;
+            left -= (size_t)n;
+        }
+        free(buf);
+    }
@@ -0,0 +1,238 @@
+/*
+ * ======================================================================================
+ * TOPIC: DOUBLY LINKED LIST IN A CONTIGUOUS ARENA (index links)
+ * ======================================================================================
+ * 02_doubly_linked_list.c mallocs every node and links them with two 8-byte pointers.
+ * Here all nodes live in one std::vector and link to each other by 32-bit index:
+ *
+ * 1. Links cost 2 x 4 bytes instead of 2 x 8 bytes on a 64-bit machine.
+ * 2. Deleted slots go on a free list and are reused by the next insert.
+ * 3. compact() rewrites the arena in list order, so a traversal after many
+ *    inserts/deletes walks memory front to back again.
+ *
+ * NIL (UINT32_MAX) is the null link, so the arena holds at most NIL slots (or a
+ * smaller limit given to the constructor); inserts into a full arena return false.
+ *
+ * The operations mirror the C program: insertion_beginning / insertion_last /
+ * insertion_specified and deletion_beginning / deletion_last / deletion_specified.
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+class ArenaList {
+public:
+    static const uint32_t NIL = UINT32_MAX;
+
+    // max_slots caps the arena; it can never exceed NIL, which is not a valid index.
+    explicit ArenaList(uint32_t max_slots = NIL) : limit(max_slots) {}
+
+    bool empty() const { return head == NIL; }
+    size_t size() const { return count; }
+    size_t capacity() const { return nodes.size(); }
+    static size_t node_bytes() { return sizeof(Node); }
+
+    bool insertion_beginning(int item) {
+        uint32_t n = allocate(item);
+        if (n == NIL)
+            return false;
+        nodes[n].next = head;
+        if (head != NIL)
+            nodes[head].prev = n;
+        else
+            tail = n;
+        head = n;
+        return true;
+    }
+
+    bool insertion_last(int item) {
+        uint32_t n = allocate(item);
+        if (n == NIL)
+            return false;
+        nodes[n].prev = tail;
+        if (tail != NIL)
+            nodes[tail].next = n;
+        else
+            head = n;
+        tail = n;
+        return true;
+    }
+
+    // Inserts item after the node at 0-based position loc, like the C version.
+    // Returns false if the list has fewer than loc+1 elements or the arena is full.
+    bool insertion_specified(size_t loc, int item) {
+        uint32_t temp = at(loc);
+        if (temp == NIL)
+            return false;
+        uint32_t n = allocate(item);
+        if (n == NIL)
+            return false;
+        nodes[n].prev = temp;
+        nodes[n].next = nodes[temp].next;
+        if (nodes[temp].next != NIL)
+            nodes[nodes[temp].next].prev = n;
+        else
+            tail = n;
+        nodes[temp].next = n;
+        return true;
+    }
+
+    bool deletion_beginning() {
+        if (head == NIL)
+            return false;
+        unlink(head);
+        return true;
+    }
+
+    bool deletion_last() {
+        if (tail == NIL)
+            return false;
+        unlink(tail);
+        return true;
+    }
+
+    // Deletes the node after the first node holding val.
+    bool deletion_specified(int val) {
+        uint32_t ptr = find(val);
+        if (ptr == NIL || nodes[ptr].next == NIL)
+            return false;
+        unlink(nodes[ptr].next);
+        return true;
+    }
+
+    // Returns the 0-based position of item, or -1.
+    long search(int item) const {
+        long i = 0;
+        for (uint32_t p = head; p != NIL; p = nodes[p].next, i++)
+            if (nodes[p].data == item)
+                return i;
+        return -1;
+    }
+
+    void display() const {
+        cout << "\n printing values...\n";
+        for (uint32_t p = head; p != NIL; p = nodes[p].next)
+            cout << nodes[p].data << "\n";
+    }
+
+    // Rebuilds the arena so node i of the list sits in slot i, drops the free
+    // list and releases the unused capacity.
+    void compact() {
+        vector<Node> packed;
+        packed.reserve(count);
+        for (uint32_t p = head; p != NIL; p = nodes[p].next) {
+            uint32_t i = (uint32_t)packed.size();
+            packed.push_back({nodes[p].data, i == 0 ? NIL : i - 1, i + 1});
+        }
+        if (!packed.empty())
+            packed.back().next = NIL;
+        nodes.swap(packed);
+        nodes.shrink_to_fit();
+        head = count ? 0 : NIL;
+        tail = count ? (uint32_t)(count - 1) : NIL;
+        free_head = NIL;
+    }
+
+private:
+    struct Node {
+        int data;
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    vector<Node> nodes;
+    uint32_t head = NIL;
+    uint32_t tail = NIL;
+    uint32_t free_head = NIL;   // free slots are chained through Node::next
+    size_t count = 0;
+    uint32_t limit;             // slots never reach NIL, so index NIL stays the sentinel
+
+    // Returns the slot for a new node, or NIL when the arena is full.
+    uint32_t allocate(int item) {
+        uint32_t n;
+        if (free_head != NIL) {
+            n = free_head;
+            free_head = nodes[n].next;
+        } else {
+            if (nodes.size() >= limit)
+                return NIL;
+            n = (uint32_t)nodes.size();
+            nodes.push_back(Node());
+        }
+        nodes[n] = {item, NIL, NIL};
+        count++;
+        return n;
+    }
+
+    void unlink(uint32_t n) {
+        Node& node = nodes[n];
+        if (node.prev != NIL)
+            nodes[node.prev].next = node.next;
+        else
+            head = node.next;
+        if (node.next != NIL)
+            nodes[node.next].prev = node.prev;
+        else
+            tail = node.prev;
+        node.next = free_head;
+        free_head = n;
+        count--;
+    }
+
+    uint32_t at(size_t loc) const {
+        uint32_t p = head;
+        for (size_t i = 0; i < loc && p != NIL; i++)
+            p = nodes[p].next;
+        return p;
+    }
+
+    uint32_t find(int val) const {
+        for (uint32_t p = head; p != NIL; p = nodes[p].next)
+            if (nodes[p].data == val)
+                return p;
+        return NIL;
+    }
+};
+
+int main() {
+    ArenaList list;
+
+    for (int i = 1; i <= 5; i++)
+        list.insertion_last(i * 10);        // 10 20 30 40 50
+    list.insertion_beginning(5);            // 5 10 20 30 40 50
+    list.insertion_specified(2, 25);        // 5 10 20 25 30 40 50
+    list.deletion_specified(30);            // 5 10 20 25 30 50
+    list.deletion_beginning();              // 10 20 25 30 50
+    list.deletion_last();                   // 10 20 25 30
+    list.display();
+
+    cout << "25 found at location " << list.search(25) + 1 << endl;
+    struct PtrNode { PtrNode *prev, *next; int data; };
+    cout << "Node size: " << ArenaList::node_bytes() << " bytes (pointer version: "
+         << sizeof(PtrNode) << " bytes)" << endl;
+
+    // Freed slots are reused, then compaction restores list order in memory.
+    list.insertion_last(60);
+    cout << "Size " << list.size() << ", arena slots " << list.capacity() << endl;
+    list.compact();
+    cout << "After compact: size " << list.size() << ", arena slots " << list.capacity() << endl;
+    list.display();
+
+    // A full arena refuses inserts instead of handing out an index that could
+    // collide with NIL; a freed slot makes room again.
+    ArenaList small(3);
+    bool ok = small.insertion_last(1) && small.insertion_last(2) && small.insertion_beginning(0);
+    bool full = !small.insertion_last(3) && !small.insertion_beginning(3) &&
+                !small.insertion_specified(0, 3);
+    small.deletion_last();
+    bool reuse = small.insertion_last(4) && small.search(4) == 2 && small.size() == 3;
+    cout << "Arena of 3: fills " << (ok ? "ok" : "FAILED") << ", rejects when full "
+         << (full ? "ok" : "FAILED") << ", reuses freed slot " << (reuse ? "ok" : "FAILED")
+         << endl;
+
+    return 0;
+}
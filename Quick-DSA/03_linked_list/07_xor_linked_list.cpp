@@ -0,0 +1,348 @@
+/*
+ * ======================================================================================
+ * TOPIC: XOR LINKED LIST (memory-compact doubly linked list)
+ * ======================================================================================
+ * Each node stores one field, link = address(prev) XOR address(next), instead of the
+ * separate prev/next pointers of 02_doubly_linked_list.c. Walking from either end only
+ * needs the address of the node we came from:
+ *
+ *      next = prev XOR node->link
+ *
+ * 1. One pointer per node instead of two (16 bytes per int node instead of 24).
+ * 2. Traversal works in both directions, starting from head or from tail.
+ * 3. Insert/delete at either end is O(1) because both ends are kept.
+ *
+ * glibc malloc rounds both a 16 and a 24 byte request up to a 32 byte chunk, so with
+ * one `new` per node the XOR list would save nothing. Nodes therefore come from a
+ * NodePool: 64K-node chunks with popped nodes kept on a free list, so a node really
+ * costs sizeof(Node) bytes.
+ *
+ * main() builds N nodes (default 10,000,000) as an XOR list, as a pooled two-pointer
+ * list and as a two-pointer list with one `new` per node, and reports the resident
+ * memory (RSS) each one adds and its forward/backward traversal time.
+ *      Usage: ./a.out [N]
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <fstream>
+#include <unistd.h>
+
+using namespace std;
+
+// Hands out T slots from chunks of CHUNK and keeps released slots on a free list
+// threaded through the slots themselves. Chunks are only freed with the pool.
+template <class T, size_t CHUNK = 65536>
+class NodePool {
+public:
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // The source is left empty, as if newly constructed.
+    NodePool(NodePool&& other) noexcept
+        : chunks(std::move(other.chunks)), free_list(other.free_list), used(other.used) {
+        other.reset();
+    }
+
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            chunks = std::move(other.chunks);
+            free_list = other.free_list;
+            used = other.used;
+            other.reset();
+        }
+        return *this;
+    }
+
+    T* allocate() {
+        if (free_list != nullptr) {
+            Slot* s = free_list;
+            free_list = s->next;
+            return reinterpret_cast<T*>(s);
+        }
+        if (used == CHUNK) {
+            chunks.emplace_back(new Slot[CHUNK]);
+            used = 0;
+        }
+        return reinterpret_cast<T*>(&chunks.back()[used++]);
+    }
+
+    void release(T* p) {
+        Slot* s = reinterpret_cast<Slot*>(p);
+        s->next = free_list;
+        free_list = s;
+    }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    static_assert(is_trivially_destructible<T>::value, "pool never runs destructors");
+
+    vector<unique_ptr<Slot[]>> chunks;
+    Slot* free_list = nullptr;
+    size_t used = CHUNK;
+
+    void reset() {
+        chunks.clear();
+        free_list = nullptr;
+        used = CHUNK;
+    }
+};
+
+class XorList {
+public:
+    XorList() = default;
+
+    // Owns its nodes: no copies, moves hand over the pool.
+    XorList(const XorList&) = delete;
+    XorList& operator=(const XorList&) = delete;
+
+    XorList(XorList&& other) noexcept
+        : pool(std::move(other.pool)), head(other.head), tail(other.tail), count(other.count) {
+        other.head = other.tail = nullptr;
+        other.count = 0;
+    }
+
+    XorList& operator=(XorList&& other) noexcept {
+        swap(pool, other.pool);
+        swap(head, other.head);
+        swap(tail, other.tail);
+        swap(count, other.count);
+        return *this;
+    }
+
+    bool empty() const { return head == nullptr; }
+    size_t size() const { return count; }
+    static size_t node_bytes() { return sizeof(Node); }
+
+    void push_front(int item) {
+        Node* n = new (pool.allocate()) Node{item, addr(head)};
+        if (head != nullptr)
+            head->link ^= addr(n);      // head's prev was null, becomes n
+        else
+            tail = n;
+        head = n;
+        count++;
+    }
+
+    void push_back(int item) {
+        Node* n = new (pool.allocate()) Node{item, addr(tail)};
+        if (tail != nullptr)
+            tail->link ^= addr(n);
+        else
+            head = n;
+        tail = n;
+        count++;
+    }
+
+    // Both pops assume the list is non-empty.
+    int pop_front() {
+        Node* n = head;
+        Node* next = (Node*)n->link;    // prev of head is null
+        if (next != nullptr)
+            next->link ^= addr(n);
+        else
+            tail = nullptr;
+        head = next;
+        int item = n->data;
+        pool.release(n);
+        count--;
+        return item;
+    }
+
+    int pop_back() {
+        Node* n = tail;
+        Node* prev = (Node*)n->link;
+        if (prev != nullptr)
+            prev->link ^= addr(n);
+        else
+            head = nullptr;
+        tail = prev;
+        int item = n->data;
+        pool.release(n);
+        count--;
+        return item;
+    }
+
+    // Calls f(data) for every node, front to back.
+    template <class F>
+    void for_each(F f) const { walk(head, f); }
+
+    // Calls f(data) for every node, back to front.
+    template <class F>
+    void for_each_reverse(F f) const { walk(tail, f); }
+
+private:
+    struct Node {
+        int data;
+        uintptr_t link;
+    };
+
+    NodePool<Node> pool;                // declared first: nodes die with it
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    size_t count = 0;
+
+    static uintptr_t addr(Node* n) { return (uintptr_t)n; }
+
+    template <class F>
+    static void walk(Node* start, F& f) {
+        uintptr_t prev = 0;
+        Node* cur = start;
+        while (cur != nullptr) {
+            f(cur->data);
+            Node* next = (Node*)(prev ^ cur->link);
+            prev = addr(cur);
+            cur = next;
+        }
+    }
+};
+
+// Plain two-pointer list used as the baseline in the benchmark.
+struct PtrNode {
+    PtrNode* prev;
+    PtrNode* next;
+    int data;
+};
+
+static double seconds_since(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// Resident set size of this process, from /proc/self/statm (0 if unavailable).
+static size_t rss_bytes() {
+    ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+struct Run {
+    double build, fwd, bwd;
+    size_t rss;
+};
+
+static void report(const char* name, size_t node, long n, const Run& r) {
+    cout << name << "node " << node << " B, RSS +" << r.rss / (1 << 20) << " MiB ("
+         << (n ? (double)r.rss / n : 0) << " B/node), build " << r.build << " s, forward "
+         << r.fwd << " s, backward " << r.bwd << " s\n";
+}
+
+// Two-pointer list; `pooled` takes nodes from a NodePool instead of `new`.
+static Run pointer_list(long n, bool pooled, long long& sum) {
+    Run r;
+    NodePool<PtrNode> pool;
+    PtrNode* head = nullptr;
+    PtrNode* tail = nullptr;
+    size_t rss0 = rss_bytes();
+    auto t0 = chrono::steady_clock::now();
+    for (long i = 0; i < n; i++) {
+        void* mem = pooled ? (void*)pool.allocate() : ::operator new(sizeof(PtrNode));
+        PtrNode* p = new (mem) PtrNode{tail, nullptr, (int)i};
+        if (tail != nullptr)
+            tail->next = p;
+        else
+            head = p;
+        tail = p;
+    }
+    r.build = seconds_since(t0);
+    r.rss = rss_bytes() - rss0;
+
+    t0 = chrono::steady_clock::now();
+    for (PtrNode* p = head; p != nullptr; p = p->next)
+        sum += p->data;
+    r.fwd = seconds_since(t0);
+    t0 = chrono::steady_clock::now();
+    for (PtrNode* p = tail; p != nullptr; p = p->prev)
+        sum -= p->data;
+    r.bwd = seconds_since(t0);
+
+    if (!pooled) {
+        while (head != nullptr) {
+            PtrNode* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    long n = argc > 1 ? atol(argv[1]) : 10000000;
+
+    // Small demo of both ends.
+    XorList demo;
+    demo.push_back(20);
+    demo.push_back(30);
+    demo.push_front(10);
+    demo.push_back(40);                 // 10 20 30 40
+    demo.pop_back();
+    demo.pop_front();                   // 20 30
+    demo.push_front(5);                 // reuses a popped node
+    cout << "Forward: ";
+    demo.for_each([](int x) { cout << x << " "; });
+    cout << "\nBackward: ";
+    demo.for_each_reverse([](int x) { cout << x << " "; });
+    XorList moved(std::move(demo));
+    cout << "\nAfter move: " << moved.size() << " nodes, source " << demo.size() << "\n";
+
+    // The moved-from lists must not share slots with their new owners.
+    XorList a;
+    a.push_back(1);
+    a.push_back(2);
+    a.push_back(3);
+    XorList b;
+    b = std::move(a);
+    b.pop_front();                      // a free slot in b's pool
+    a.push_back(7);
+    a.push_back(8);
+    XorList c(std::move(b));
+    b.push_back(9);
+    cout << "Reuse after move: a = ";
+    a.for_each([](int x) { cout << x << " "; });
+    cout << ", b = ";
+    b.for_each([](int x) { cout << x << " "; });
+    cout << ", c = ";
+    c.for_each([](int x) { cout << x << " "; });
+    cout << "\n\n";
+
+    // Benchmark: XOR list. Each list is freed before the next is built, and the
+    // per-node `new` list goes last because glibc keeps its freed heap.
+    long long sum = 0;
+    Run x;
+    {
+        XorList xl;
+        size_t rss0 = rss_bytes();
+        auto t0 = chrono::steady_clock::now();
+        for (long i = 0; i < n; i++)
+            xl.push_back((int)i);
+        x.build = seconds_since(t0);
+        x.rss = rss_bytes() - rss0;
+
+        t0 = chrono::steady_clock::now();
+        xl.for_each([&](int v) { sum += v; });
+        x.fwd = seconds_since(t0);
+        t0 = chrono::steady_clock::now();
+        xl.for_each_reverse([&](int v) { sum -= v; });
+        x.bwd = seconds_since(t0);
+    }
+    Run pooled = pointer_list(n, true, sum);
+    Run plain = pointer_list(n, false, sum);
+
+    cout << "N = " << n << " (checksum " << sum << ")\n";
+    report("XOR list, pooled:         ", XorList::node_bytes(), n, x);
+    report("Pointer list, pooled:     ", sizeof(PtrNode), n, pooled);
+    report("Pointer list, new / node: ", sizeof(PtrNode), n, plain);
+    return 0;
+}
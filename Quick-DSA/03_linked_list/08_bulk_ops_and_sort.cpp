@@ -0,0 +1,304 @@
+/*
+ * ======================================================================================
+ * TOPIC: BULK OPERATIONS AND MERGE SORT ON LINKED LISTS
+ * ======================================================================================
+ * The menu programs (01_single_linked_list.c, 02_doubly_linked_list.c) insert one
+ * scanf'd value per malloc. This file adds the batch operations they are missing:
+ *
+ * 1. from_array(): builds the whole list with a single allocation of n nodes.
+ * 2. erase_if(pred) and remove_duplicates() in one pass.
+ * 3. sort(): merge sort that relinks nodes (payloads never move).
+ *
+ * sort() uses the "bins" form of bottom-up merge sort: each node is merged into
+ * bins[0], a full bin i is merged into bin i+1, and so on. Bin i holds a sorted run
+ * of 2^i nodes, so small merges happen on nodes that were just touched and are still
+ * in cache, instead of sweeping the whole list once per pass. O(n log n), no recursion,
+ * O(1) extra space (64 bin pointers).
+ *
+ * main() times sort() against copying the values to a vector, std::sort and copying
+ * them back, on a list whose node order is shuffled in memory.
+ *      Usage: ./a.out [N]
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <unordered_set>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+struct SNode {
+    int data;
+    SNode* next;
+};
+
+struct DNode {
+    DNode* prev;
+    DNode* next;
+    int data;
+};
+
+// Merges two sorted singly linked runs linked through ->next; stable.
+template <class Node>
+static Node* merge_runs(Node* a, Node* b) {
+    Node dummy;
+    Node* t = &dummy;
+    while (a && b) {
+        if (b->data < a->data) {
+            t->next = b;
+            b = b->next;
+        } else {
+            t->next = a;
+            a = a->next;
+        }
+        t = t->next;
+    }
+    t->next = a ? a : b;
+    return dummy.next;
+}
+
+// Sorts a null-terminated chain through ->next, returns the new head.
+template <class Node>
+static Node* sort_chain(Node* head) {
+    Node* bins[64] = {};
+    int used = 0;
+    while (head) {
+        Node* run = head;
+        head = head->next;
+        run->next = nullptr;
+        int i = 0;
+        for (; i < used && bins[i]; i++) {
+            run = merge_runs(bins[i], run);
+            bins[i] = nullptr;
+        }
+        if (i == used)
+            used++;
+        bins[i] = run;
+    }
+    Node* result = nullptr;
+    for (int i = 0; i < used; i++)
+        if (bins[i])
+            result = merge_runs(bins[i], result);
+    return result;
+}
+
+// Singly linked list owning its nodes in blocks; erased nodes are recycled.
+class SList {
+public:
+    SNode* head = nullptr;
+
+    static SList from_array(const int* a, size_t n) {
+        SList l;
+        if (n == 0)
+            return l;
+        SNode* block = l.new_block(n);
+        for (size_t i = 0; i < n; i++) {
+            block[i].data = a[i];
+            block[i].next = i + 1 < n ? &block[i + 1] : nullptr;
+        }
+        l.head = block;
+        return l;
+    }
+
+    void beginsert(int item) {
+        SNode* p = free_list;
+        if (p)
+            free_list = p->next;
+        else
+            p = new_block(1);
+        p->data = item;
+        p->next = head;
+        head = p;
+    }
+
+    template <class Pred>
+    size_t erase_if(Pred pred) {
+        size_t removed = 0;
+        SNode** link = &head;
+        while (*link) {
+            SNode* p = *link;
+            if (pred(p->data)) {
+                *link = p->next;
+                release(p);
+                removed++;
+            } else {
+                link = &p->next;
+            }
+        }
+        return removed;
+    }
+
+    // Keeps the first occurrence of every value.
+    size_t remove_duplicates() {
+        unordered_set<int> seen;
+        return erase_if([&seen](int x) { return !seen.insert(x).second; });
+    }
+
+    void sort() { head = sort_chain(head); }
+
+    void display() const {
+        for (SNode* p = head; p; p = p->next)
+            cout << p->data << " ";
+        cout << endl;
+    }
+
+private:
+    vector<unique_ptr<SNode[]>> blocks;
+    SNode* free_list = nullptr;
+
+    SNode* new_block(size_t n) {
+        blocks.emplace_back(new SNode[n]);
+        return blocks.back().get();
+    }
+
+    void release(SNode* p) {
+        p->next = free_list;
+        free_list = p;
+    }
+};
+
+// Doubly linked list with the same bulk API; sort() relinks through ->next and
+// then repairs the prev pointers in one pass.
+class DList {
+public:
+    DNode* head = nullptr;
+    DNode* tail = nullptr;
+
+    static DList from_array(const int* a, size_t n) {
+        DList l;
+        if (n == 0)
+            return l;
+        l.blocks.emplace_back(new DNode[n]);
+        DNode* block = l.blocks.back().get();
+        for (size_t i = 0; i < n; i++) {
+            block[i].data = a[i];
+            block[i].prev = i > 0 ? &block[i - 1] : nullptr;
+            block[i].next = i + 1 < n ? &block[i + 1] : nullptr;
+        }
+        l.head = block;
+        l.tail = &block[n - 1];
+        return l;
+    }
+
+    template <class Pred>
+    size_t erase_if(Pred pred) {
+        size_t removed = 0;
+        DNode* p = head;
+        while (p) {
+            DNode* next = p->next;
+            if (pred(p->data)) {
+                if (p->prev)
+                    p->prev->next = next;
+                else
+                    head = next;
+                if (next)
+                    next->prev = p->prev;
+                else
+                    tail = p->prev;
+                p->next = free_list;
+                free_list = p;
+                removed++;
+            }
+            p = next;
+        }
+        return removed;
+    }
+
+    size_t remove_duplicates() {
+        unordered_set<int> seen;
+        return erase_if([&seen](int x) { return !seen.insert(x).second; });
+    }
+
+    void sort() {
+        head = sort_chain(head);
+        DNode* prev = nullptr;
+        for (DNode* p = head; p; p = p->next) {
+            p->prev = prev;
+            prev = p;
+        }
+        tail = prev;
+    }
+
+    void display() const {
+        for (DNode* p = head; p; p = p->next)
+            cout << p->data << " ";
+        cout << "| backward: ";
+        for (DNode* p = tail; p; p = p->prev)
+            cout << p->data << " ";
+        cout << endl;
+    }
+
+private:
+    vector<unique_ptr<DNode[]>> blocks;
+    DNode* free_list = nullptr;
+};
+
+static double seconds_since(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000000;
+
+    int a[] = {5, 3, 8, 3, 1, 9, 5, 2};
+    SList s = SList::from_array(a, sizeof(a) / sizeof(a[0]));
+    s.remove_duplicates();
+    s.display();                                            // 5 3 8 1 9 2
+    s.erase_if([](int x) { return x % 2 == 0; });
+    s.sort();
+    s.display();                                            // 1 3 5 9
+
+    DList d = DList::from_array(a, sizeof(a) / sizeof(a[0]));
+    d.sort();
+    d.remove_duplicates();
+    d.display();                                            // 1 2 3 5 8 9 | backward ...
+
+    // Benchmark: random values, nodes linked in shuffled memory order so the
+    // list behaves like one built by many scattered inserts.
+    mt19937 rng(42);
+    vector<int> values(n);
+    for (auto& v : values)
+        v = (int)rng();
+    vector<SNode> pool(n);
+    vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++)
+        order[i] = i;
+    shuffle(order.begin(), order.end(), rng);
+    auto build = [&]() {
+        for (size_t i = 0; i < n; i++) {
+            pool[order[i]].data = values[i];
+            pool[order[i]].next = i + 1 < n ? &pool[order[i + 1]] : nullptr;
+        }
+        return n ? &pool[order[0]] : nullptr;
+    };
+
+    SNode* head = build();
+    auto t0 = chrono::steady_clock::now();
+    head = sort_chain(head);
+    double relink = seconds_since(t0);
+    bool ok = true;
+    for (SNode* p = head; p && p->next; p = p->next)
+        ok &= p->data <= p->next->data;
+
+    head = build();
+    t0 = chrono::steady_clock::now();
+    vector<int> tmp;
+    tmp.reserve(n);
+    for (SNode* p = head; p; p = p->next)
+        tmp.push_back(p->data);
+    std::sort(tmp.begin(), tmp.end());
+    size_t i = 0;
+    for (SNode* p = head; p; p = p->next)
+        p->data = tmp[i++];
+    double copy = seconds_since(t0);
+
+    cout << "N = " << n << (ok ? " (sorted)" : " (NOT sorted)") << "\n";
+    cout << "relinking merge sort: " << relink << " s\n";
+    cout << "copy + std::sort + copy back: " << copy << " s" << endl;
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ * ======================================================================================
+ * TOPIC: RING BUFFER (contiguous replacement for the circular linked list)
+ * ======================================================================================
+ * 03_circular_linked_list.c is used for round-robin rotation, but lastinsert() and
+ * last_delete() walk the whole circle to find the tail. A ring buffer keeps the
+ * elements in one array with a head index and a size:
+ *
+ *      slot of element i = (head + i) & (capacity - 1)
+ *
+ * 1. Capacity is a power of two, so wrapping is a mask instead of a modulo.
+ * 2. push/pop at both ends are O(1).
+ * 3. rotate(k) costs O(min(k, n-k)) moves, and is a pure index change when full.
+ *
+ * FixedRing<T> has a fixed capacity and reports overflow; Ring<T> doubles when full.
+ *
+ * main() runs a round-robin scheduling loop (take the front task, run a slice, put it
+ * at the back, sometimes retire it and admit a new one) on Ring and on a node-based
+ * circular list that has to walk to its tail like the C program.
+ *      Usage: ./a.out [tasks] [slices]
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <chrono>
+
+using namespace std;
+
+static size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+template <class T>
+class FixedRing {
+public:
+    explicit FixedRing(size_t min_capacity)
+        : buf(round_up_pow2(min_capacity < 1 ? 1 : min_capacity)), mask(buf.size() - 1) {}
+
+    size_t size() const { return count; }
+    size_t capacity() const { return buf.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == buf.size(); }
+
+    // i = 0 is the front.
+    T& operator[](size_t i) { return buf[(head + i) & mask]; }
+    const T& operator[](size_t i) const { return buf[(head + i) & mask]; }
+    T& front() { return buf[head]; }
+    T& back() { return buf[(head + count - 1) & mask]; }
+
+    bool push_back(T v) {
+        if (full())
+            return false;
+        buf[(head + count) & mask] = std::move(v);
+        count++;
+        return true;
+    }
+
+    bool push_front(T v) {
+        if (full())
+            return false;
+        head = (head - 1) & mask;
+        buf[head] = std::move(v);
+        count++;
+        return true;
+    }
+
+    // Both pops assume the ring is non-empty.
+    T pop_front() {
+        T v = std::move(buf[head]);
+        head = (head + 1) & mask;
+        count--;
+        return v;
+    }
+
+    T pop_back() {
+        count--;
+        return std::move(buf[(head + count) & mask]);
+    }
+
+    // Makes element k the new front (k may be negative). When the ring is full
+    // this is just an index change; otherwise the k elements that wrap around
+    // are moved across the gap, using whichever direction moves fewer.
+    void rotate(long k) {
+        if (count == 0)
+            return;
+        long n = (long)count;
+        k %= n;
+        if (k < 0)
+            k += n;
+        if (full()) {
+            head = (head + (size_t)k) & mask;
+            return;
+        }
+        if (k <= n - k) {
+            for (long i = 0; i < k; i++)
+                push_back(pop_front());
+        } else {
+            for (long i = 0; i < n - k; i++)
+                push_front(pop_back());
+        }
+    }
+
+protected:
+    vector<T> buf;
+    size_t mask;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+// Growable ring: doubles its capacity instead of failing when full.
+template <class T>
+class Ring : public FixedRing<T> {
+    using Base = FixedRing<T>;
+
+public:
+    explicit Ring(size_t min_capacity = 16) : Base(min_capacity) {}
+
+    void push_back(T v) {
+        if (this->full())
+            grow();
+        Base::push_back(std::move(v));
+    }
+
+    void push_front(T v) {
+        if (this->full())
+            grow();
+        Base::push_front(std::move(v));
+    }
+
+private:
+    void grow() {
+        vector<T> bigger(this->buf.size() * 2);
+        for (size_t i = 0; i < this->count; i++)
+            bigger[i] = std::move((*this)[i]);
+        this->buf.swap(bigger);
+        this->mask = this->buf.size() - 1;
+        this->head = 0;
+    }
+};
+
+// Node-based circle with only a head pointer, as in 03_circular_linked_list.c.
+struct CNode {
+    int data;
+    CNode* next;
+};
+
+struct NodeCircle {
+    CNode* head = nullptr;
+
+    void lastinsert(int item) {
+        CNode* ptr = new CNode{item, nullptr};
+        if (head == nullptr) {
+            head = ptr;
+            ptr->next = head;
+            return;
+        }
+        CNode* temp = head;
+        while (temp->next != head)
+            temp = temp->next;
+        temp->next = ptr;
+        ptr->next = head;
+    }
+
+    // Removes the head and returns its value; walks to the tail to relink.
+    int begin_delete() {
+        CNode* ptr = head;
+        int item = head->data;
+        if (head->next == head) {
+            head = nullptr;
+            delete ptr;
+            return item;
+        }
+        CNode* temp = head;
+        while (temp->next != head)
+            temp = temp->next;
+        temp->next = head->next;
+        head = head->next;
+        delete ptr;
+        return item;
+    }
+
+    // Round robin on a circle is head = head->next.
+    void rotate_one() { head = head->next; }
+
+    ~NodeCircle() {
+        while (head != nullptr)
+            begin_delete();
+    }
+};
+
+static double seconds_since(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    int tasks = argc > 1 ? atoi(argv[1]) : 1000;
+    long slices = argc > 2 ? atol(argv[2]) : 2000000;
+
+    Ring<int> r(4);
+    for (int i = 1; i <= 6; i++)
+        r.push_back(i);                 // grows 4 -> 8
+    r.push_front(0);
+    r.rotate(2);                        // 2 3 4 5 6 0 1
+    r.rotate(-1);                       // 1 2 3 4 5 6 0
+    cout << "Ring (capacity " << r.capacity() << "): ";
+    for (size_t i = 0; i < r.size(); i++)
+        cout << r[i] << " ";
+    cout << endl;
+
+    // Every slice runs the front task; every 16th slice retires it and admits a
+    // new one at the back, otherwise it is rotated to the back.
+    long long work = 0;
+    Ring<int> ring(tasks);
+    for (int i = 0; i < tasks; i++)
+        ring.push_back(i);
+    auto t0 = chrono::steady_clock::now();
+    int next_id = tasks;
+    for (long s = 0; s < slices; s++) {
+        work += ring.front();
+        if ((s & 15) == 15) {
+            ring.pop_front();
+            ring.push_back(next_id++);
+        } else {
+            ring.rotate(1);
+        }
+    }
+    double ring_time = seconds_since(t0);
+
+    NodeCircle circle;
+    for (int i = 0; i < tasks; i++)
+        circle.lastinsert(i);
+    t0 = chrono::steady_clock::now();
+    next_id = tasks;
+    for (long s = 0; s < slices; s++) {
+        work -= circle.head->data;
+        if ((s & 15) == 15) {
+            circle.begin_delete();
+            circle.lastinsert(next_id++);
+        } else {
+            circle.rotate_one();
+        }
+    }
+    double circle_time = seconds_since(t0);
+
+    cout << tasks << " tasks, " << slices << " slices (checksum " << work << ")\n";
+    cout << "ring buffer:      " << ring_time << " s\n";
+    cout << "circular list:    " << circle_time << " s" << endl;
+    return 0;
+}
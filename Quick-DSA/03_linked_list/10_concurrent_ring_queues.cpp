@@ -0,0 +1,417 @@
+/*
+ * ======================================================================================
+ * TOPIC: LOCK-FREE RING QUEUES FOR HANDING WORK BETWEEN THREADS
+ * ======================================================================================
+ * The circular list in 03_circular_linked_list.c is the picture we use for passing
+ * work between threads, but it is single-threaded. These are the concurrent versions,
+ * both on a power-of-two ring (see 09_ring_buffer.cpp):
+ *
+ * SpscRing<T>  one producer, one consumer, wait-free.
+ *      head is written only by the consumer, tail only by the producer. Each side
+ *      keeps a cached copy of the other side's index and reloads it only when the
+ *      ring looks full/empty, so the shared cache lines are touched rarely.
+ *
+ * MpmcRing<T>  any number of producers and consumers, bounded (Dmitry Vyukov's design).
+ *      Every cell carries a sequence number. A producer claims position pos with a
+ *      CAS when cell.seq == pos, writes, then publishes seq = pos + 1. A consumer
+ *      claims pos when cell.seq == pos + 1 and frees the cell with seq = pos + size.
+ *
+ * The indices and every MPMC cell sit on their own 64-byte cache lines, so the
+ * producer and consumer do not false-share and neither do threads working on
+ * neighbouring cells. Both queues offer try_push_n/try_pop_n, which move a batch
+ * with one index update: a plain store for SPSC, and a single CAS that claims the
+ * whole run of ready cells for MPMC.
+ *
+ * main() measures saturated throughput, then one-way hand-off latency percentiles
+ * with one batch in flight at a time, for each producer/consumer core pair among
+ * the first few CPUs.
+ *      Build: g++ -O2 -pthread 10_concurrent_ring_queues.cpp
+ *      Usage: ./a.out [messages]
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <pthread.h>
+#include <sched.h>
+
+using namespace std;
+
+static const size_t CACHE_LINE = 64;
+
+static size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+template <class T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t min_capacity)
+        : buf(round_up_pow2(min_capacity < 2 ? 2 : min_capacity)), mask(buf.size() - 1) {}
+
+    // Producer side.
+    bool try_push(const T& v) { return try_push_n(&v, 1) == 1; }
+
+    size_t try_push_n(const T* items, size_t n) {
+        size_t t = tail.value.load(memory_order_relaxed);
+        size_t space = buf.size() - (t - producer_head_cache);
+        if (space < n) {
+            producer_head_cache = head.value.load(memory_order_acquire);
+            space = buf.size() - (t - producer_head_cache);
+        }
+        n = min(n, space);
+        for (size_t i = 0; i < n; i++)
+            buf[(t + i) & mask] = items[i];
+        tail.value.store(t + n, memory_order_release);
+        return n;
+    }
+
+    // Consumer side.
+    bool try_pop(T& out) { return try_pop_n(&out, 1) == 1; }
+
+    size_t try_pop_n(T* out, size_t n) {
+        size_t h = head.value.load(memory_order_relaxed);
+        size_t avail = consumer_tail_cache - h;
+        if (avail < n) {
+            consumer_tail_cache = tail.value.load(memory_order_acquire);
+            avail = consumer_tail_cache - h;
+        }
+        n = min(n, avail);
+        for (size_t i = 0; i < n; i++)
+            out[i] = buf[(h + i) & mask];
+        head.value.store(h + n, memory_order_release);
+        return n;
+    }
+
+private:
+    struct alignas(CACHE_LINE) PaddedIndex {
+        atomic<size_t> value{0};
+    };
+
+    vector<T> buf;
+    size_t mask;
+    PaddedIndex head;                       // next slot to read
+    PaddedIndex tail;                       // next slot to write
+    alignas(CACHE_LINE) size_t producer_head_cache = 0;
+    alignas(CACHE_LINE) size_t consumer_tail_cache = 0;
+};
+
+template <class T>
+class MpmcRing {
+public:
+    explicit MpmcRing(size_t min_capacity)
+        : cells(round_up_pow2(min_capacity < 2 ? 2 : min_capacity)), mask(cells.size() - 1) {
+        for (size_t i = 0; i < cells.size(); i++)
+            cells[i].seq.store(i, memory_order_relaxed);
+    }
+
+    bool try_push(const T& v) {
+        size_t pos = enqueue_pos.value.load(memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells[pos & mask];
+            size_t seq = c.seq.load(memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (enqueue_pos.value.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    c.data = v;
+                    c.seq.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;               // full
+            } else {
+                pos = enqueue_pos.value.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& out) {
+        size_t pos = dequeue_pos.value.load(memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells[pos & mask];
+            size_t seq = c.seq.load(memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.value.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    out = c.data;
+                    c.seq.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;               // empty
+            } else {
+                pos = dequeue_pos.value.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claims the run of free cells starting at enqueue_pos (at most n) with one
+    // CAS, then fills and publishes them; returns how many were pushed.
+    size_t try_push_n(const T* items, size_t n) {
+        if (n == 0)
+            return 0;
+        size_t pos = enqueue_pos.value.load(memory_order_relaxed);
+        for (;;) {
+            size_t k = ready_run(pos, 0, n);
+            if (k == 0) {
+                intptr_t diff = (intptr_t)cells[pos & mask].seq.load(memory_order_acquire) - (intptr_t)pos;
+                if (diff < 0)
+                    return 0;               // full
+                pos = enqueue_pos.value.load(memory_order_relaxed);
+                continue;
+            }
+            if (enqueue_pos.value.compare_exchange_weak(pos, pos + k, memory_order_relaxed)) {
+                for (size_t i = 0; i < k; i++) {
+                    Cell& c = cells[(pos + i) & mask];
+                    c.data = items[i];
+                    c.seq.store(pos + i + 1, memory_order_release);
+                }
+                return k;
+            }
+        }
+    }
+
+    // Same for consumers: one CAS on dequeue_pos takes the run of published cells.
+    size_t try_pop_n(T* out, size_t n) {
+        if (n == 0)
+            return 0;
+        size_t pos = dequeue_pos.value.load(memory_order_relaxed);
+        for (;;) {
+            size_t k = ready_run(pos, 1, n);
+            if (k == 0) {
+                intptr_t diff = (intptr_t)cells[pos & mask].seq.load(memory_order_acquire) - (intptr_t)(pos + 1);
+                if (diff < 0)
+                    return 0;               // empty
+                pos = dequeue_pos.value.load(memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos.value.compare_exchange_weak(pos, pos + k, memory_order_relaxed)) {
+                for (size_t i = 0; i < k; i++) {
+                    Cell& c = cells[(pos + i) & mask];
+                    out[i] = c.data;
+                    c.seq.store(pos + i + mask + 1, memory_order_release);
+                }
+                return k;
+            }
+        }
+    }
+
+private:
+    struct alignas(CACHE_LINE) Cell {
+        atomic<size_t> seq;
+        T data;
+    };
+
+    // Number of consecutive cells from pos (at most n) whose seq is pos + i + lag:
+    // lag 0 finds cells free for producers, lag 1 cells published for consumers.
+    size_t ready_run(size_t pos, size_t lag, size_t n) const {
+        n = min(n, cells.size());
+        size_t k = 0;
+        while (k < n && cells[(pos + k) & mask].seq.load(memory_order_acquire) == pos + k + lag)
+            k++;
+        return k;
+    }
+    struct alignas(CACHE_LINE) PaddedIndex {
+        atomic<size_t> value{0};
+    };
+
+    vector<Cell> cells;
+    size_t mask;
+    PaddedIndex enqueue_pos;
+    PaddedIndex dequeue_pos;
+};
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+static uint64_t now_ns() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+struct Result {
+    double mops;
+    uint64_t p50, p99, p999;
+};
+
+// Moves `messages` items through a fresh queue in batches of BATCH. Every item
+// carries its timestamp, set on the push attempt that actually enqueues it; the
+// consumer records receive time - that time. With `paced` the producer waits
+// until the consumer has taken the previous batch, so the queue never backs up
+// and the figures are hand-off latency rather than time spent queued.
+template <class Queue>
+static double transfer(int producer_cpu, int consumer_cpu, size_t messages, bool paced, vector<uint64_t>& lat) {
+    const size_t BATCH = 16;
+    Queue q(1024);
+    atomic<size_t> received{0};
+
+    uint64_t start = now_ns();
+    thread consumer([&]() {
+        pin_to_cpu(consumer_cpu);
+        uint64_t buf[BATCH];
+        size_t got = 0;
+        while (got < messages) {
+            size_t k = q.try_pop_n(buf, min(BATCH, messages - got));
+            if (k == 0) {
+                this_thread::yield();
+                continue;
+            }
+            uint64_t t = now_ns();
+            for (size_t i = 0; i < k; i++)
+                lat[got + i] = t - buf[i];
+            got += k;
+            received.store(got, memory_order_release);
+        }
+    });
+    thread producer([&]() {
+        pin_to_cpu(producer_cpu);
+        uint64_t buf[BATCH];
+        size_t sent = 0;
+        while (sent < messages) {
+            size_t k = min(BATCH, messages - sent);
+            if (paced)
+                while (received.load(memory_order_acquire) < sent)
+                    this_thread::yield();
+            size_t done = 0;
+            while (done < k) {
+                uint64_t t = now_ns();
+                for (size_t i = done; i < k; i++)
+                    buf[i] = t;
+                size_t pushed = q.try_push_n(buf + done, k - done);
+                if (pushed == 0)
+                    this_thread::yield();
+                done += pushed;
+            }
+            sent += k;
+        }
+    });
+    producer.join();
+    consumer.join();
+    return (now_ns() - start) / 1e9;
+}
+
+// Throughput from a saturated run, latency percentiles from a paced one.
+template <class Queue>
+static Result run_pair(int producer_cpu, int consumer_cpu, size_t messages) {
+    vector<uint64_t> lat(messages);
+    double secs = transfer<Queue>(producer_cpu, consumer_cpu, messages, false, lat);
+    transfer<Queue>(producer_cpu, consumer_cpu, messages, true, lat);
+
+    sort(lat.begin(), lat.end());
+    Result r;
+    r.mops = messages / secs / 1e6;
+    r.p50 = lat[messages / 2];
+    r.p99 = lat[messages * 99 / 100];
+    r.p999 = lat[messages * 999 / 1000];
+    return r;
+}
+
+static void report(const char* name, int p, int c, const Result& r) {
+    cout << name << " cpu" << p << " -> cpu" << c << ": " << r.mops << " M msg/s, latency p50 "
+         << r.p50 << " ns, p99 " << r.p99 << " ns, p99.9 " << r.p999 << " ns" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t messages = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    if (messages == 0)
+        messages = 1;
+
+    SpscRing<int> s(4);
+    int in[] = {1, 2, 3, 4, 5, 6};
+    int out[6];
+    size_t pushed = s.try_push_n(in, 6);
+    size_t popped = s.try_pop_n(out, 6);
+    cout << "SPSC capacity 4: pushed " << pushed << ", popped " << popped << ": ";
+    for (size_t i = 0; i < popped; i++)
+        cout << out[i] << " ";
+    cout << "\n";
+
+    // MPMC batches: the ring takes what fits, in order, and hands it back
+    MpmcRing<int> m(4);
+    pushed = m.try_push_n(in, 6);
+    popped = m.try_pop_n(out, 3);
+    size_t pushed2 = m.try_push_n(in + pushed, 6 - pushed);
+    size_t popped2 = m.try_pop_n(out + popped, 6 - popped);
+    cout << "MPMC capacity 4: pushed " << pushed << " + " << pushed2 << ", popped " << popped << " + "
+         << popped2 << ": ";
+    for (size_t i = 0; i < popped + popped2; i++)
+        cout << out[i] << " ";
+    cout << "\n";
+
+    // Four producers and four consumers on one MPMC ring, in batches: every value
+    // must come out exactly once.
+    {
+        const int PER = 200000;
+        MpmcRing<int> ring(256);
+        vector<atomic<int>> seen(4 * PER);
+        vector<thread> ts;
+        atomic<int> taken{0};
+        for (int t = 0; t < 4; t++) {
+            ts.emplace_back([&, t]() {
+                int b[8];
+                for (int i = 0; i < PER;) {
+                    int k = min(8, PER - i);
+                    for (int j = 0; j < k; j++)
+                        b[j] = t * PER + i + j;
+                    size_t done = 0;
+                    while (done < (size_t)k) {
+                        size_t n = ring.try_push_n(b + done, k - done);
+                        if (n == 0)
+                            this_thread::yield();
+                        done += n;
+                    }
+                    i += k;
+                }
+            });
+            ts.emplace_back([&]() {
+                int b[8];
+                while (taken.load() < 4 * PER) {
+                    size_t n = ring.try_pop_n(b, 8);
+                    if (n == 0) {
+                        this_thread::yield();
+                        continue;
+                    }
+                    for (size_t j = 0; j < n; j++)
+                        seen[b[j]]++;
+                    taken += (int)n;
+                }
+            });
+        }
+        for (auto& t : ts)
+            t.join();
+        int wrong = 0;
+        for (auto& x : seen)
+            wrong += x.load() != 1;
+        cout << "MPMC 4x4 threads, " << 4 * PER << " values in batches: " << wrong << " lost or duplicated\n";
+    }
+    cout << "\n";
+
+    int cpus = (int)thread::hardware_concurrency();
+    int use = max(1, min(cpus, 4));
+    for (int p = 0; p < use; p++) {
+        for (int c = 0; c < use; c++) {
+            if (p == c && use > 1)
+                continue;
+            report("SPSC", p, c, run_pair<SpscRing<uint64_t>>(p, c, messages));
+            report("MPMC", p, c, run_pair<MpmcRing<uint64_t>>(p, c, messages));
+        }
+    }
+    return 0;
+}
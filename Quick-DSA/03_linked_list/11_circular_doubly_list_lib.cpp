@@ -0,0 +1,60 @@
+/*
+ * ======================================================================================
+ * TOPIC: O(1) TAIL OPERATIONS, SPLICE AND ROTATE ON A CIRCULAR DOUBLY LINKED LIST
+ * ======================================================================================
+ * 04_circular_doubly_linkedlist.c keeps head->prev as the tail but still loops from
+ * head in insertion_last() and deletion_last(). circular_dlist.h uses that prev link
+ * directly, and adds whole-circle splicing and rotation. This program walks through
+ * the same menu operations on it.
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include "circular_dlist.h"
+
+using namespace std;
+
+struct node {
+    node* prev = nullptr;
+    node* next = nullptr;
+    int data;
+    explicit node(int d) : data(d) {}
+};
+
+static void display(const char* label, const CircularDList<node>& l) {
+    cout << label;
+    l.for_each([](node* p) { cout << p->data << " "; });
+    cout << endl;
+}
+
+int main() {
+    node n[10] = {node(0), node(1), node(2), node(3), node(4),
+                  node(5), node(6), node(7), node(8), node(9)};
+
+    CircularDList<node> a, b;
+    a.push_back(&n[1]);                     // insertion_last, O(1)
+    a.push_back(&n[2]);
+    a.push_back(&n[3]);
+    a.push_front(&n[0]);                    // insertion_beginning
+    display("a: ", a);                      // 0 1 2 3
+
+    a.pop_back();                           // deletion_last, O(1)
+    a.pop_front();                          // deletion_beginning
+    display("a after pops: ", a);           // 1 2
+
+    for (int i = 4; i < 10; i++)
+        b.push_back(&n[i]);
+    a.splice_back(b);                       // O(1), b becomes empty
+    display("a after splice: ", a);         // 1 2 4 5 6 7 8 9
+    cout << "b size: " << b.size() << endl;
+
+    a.rotate();                             // 2 4 5 6 7 8 9 1
+    a.rotate_back();                        // 1 2 4 5 6 7 8 9
+    a.rotate(6);                            // walks 2 steps back instead of 6 forward
+    display("a rotated by 6: ", a);         // 8 9 1 2 4 5 6 7
+
+    a.unlink(&n[5]);                        // O(1) removal from the middle
+    display("a without 5: ", a);
+    cout << "head " << a.head()->data << ", tail " << a.tail()->data << endl;
+    return 0;
+}
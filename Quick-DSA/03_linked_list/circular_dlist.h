@@ -0,0 +1,152 @@
+/*
+ * ======================================================================================
+ * circular_dlist.h: CIRCULAR DOUBLY LINKED LIST (library version)
+ * ======================================================================================
+ * Library form of 04_circular_doubly_linkedlist.c. The list is intrusive: it links
+ * nodes the caller owns, and any struct with `prev` and `next` pointers to itself
+ * can be a node. It never allocates or frees.
+ *
+ * As in the C program, head->prev is the tail, so every end operation is O(1):
+ *
+ *      push_front / push_back / pop_front / pop_back   O(1)
+ *      unlink(node)                                    O(1)
+ *      splice_back(other)  moves a whole circle in     O(1)
+ *      rotate() / rotate_back()                        O(1)
+ *      rotate(k)  walks min(k, n-k) links              O(min(k, n-k))
+ *
+ * A node that is not in any list has prev == next == nullptr.
+ * ======================================================================================
+ */
+
+#ifndef CIRCULAR_DLIST_H
+#define CIRCULAR_DLIST_H
+
+#include <cstddef>
+
+template <class Node>
+class CircularDList {
+public:
+    CircularDList() = default;
+    CircularDList(const CircularDList&) = delete;
+    CircularDList& operator=(const CircularDList&) = delete;
+
+    bool empty() const { return head_ == nullptr; }
+    size_t size() const { return count_; }
+    Node* head() const { return head_; }
+    Node* tail() const { return head_ ? head_->prev : nullptr; }
+
+    void push_back(Node* n) {
+        if (head_ == nullptr) {
+            n->prev = n->next = n;
+            head_ = n;
+        } else {
+            insert_before(head_, n);
+        }
+        count_++;
+    }
+
+    void push_front(Node* n) {
+        push_back(n);
+        head_ = n;
+    }
+
+    // Pops return nullptr on an empty list.
+    Node* pop_front() {
+        Node* n = head_;
+        if (n != nullptr)
+            unlink(n);
+        return n;
+    }
+
+    Node* pop_back() {
+        Node* n = tail();
+        if (n != nullptr)
+            unlink(n);
+        return n;
+    }
+
+    // n must currently be in this list.
+    void unlink(Node* n) {
+        if (n->next == n) {
+            head_ = nullptr;
+        } else {
+            n->prev->next = n->next;
+            n->next->prev = n->prev;
+            if (head_ == n)
+                head_ = n->next;
+        }
+        n->prev = n->next = nullptr;
+        count_--;
+    }
+
+    // Appends every node of other after our tail and leaves other empty.
+    void splice_back(CircularDList& other) {
+        if (other.head_ == nullptr)
+            return;
+        if (head_ == nullptr) {
+            head_ = other.head_;
+        } else {
+            Node* a_tail = head_->prev;
+            Node* b_head = other.head_;
+            Node* b_tail = b_head->prev;
+            a_tail->next = b_head;
+            b_head->prev = a_tail;
+            b_tail->next = head_;
+            head_->prev = b_tail;
+        }
+        count_ += other.count_;
+        other.head_ = nullptr;
+        other.count_ = 0;
+    }
+
+    // Head moves one step forward: the old head becomes the tail.
+    void rotate() {
+        if (head_ != nullptr)
+            head_ = head_->next;
+    }
+
+    // Head moves one step back: the old tail becomes the head.
+    void rotate_back() {
+        if (head_ != nullptr)
+            head_ = head_->prev;
+    }
+
+    // Head moves k steps forward (k may be negative), walking whichever way round
+    // the circle is shorter.
+    void rotate(long k) {
+        if (count_ == 0)
+            return;
+        long n = (long)count_;
+        k %= n;
+        if (k < 0)
+            k += n;
+        if (k <= n - k) {
+            for (long i = 0; i < k; i++)
+                head_ = head_->next;
+        } else {
+            for (long i = 0; i < n - k; i++)
+                head_ = head_->prev;
+        }
+    }
+
+    // Calls f(node) from head to tail. f must not unlink nodes.
+    template <class F>
+    void for_each(F f) const {
+        Node* p = head_;
+        for (size_t i = 0; i < count_; i++, p = p->next)
+            f(p);
+    }
+
+private:
+    Node* head_ = nullptr;
+    size_t count_ = 0;
+
+    static void insert_before(Node* pos, Node* n) {
+        n->next = pos;
+        n->prev = pos->prev;
+        pos->prev->next = n;
+        pos->prev = n;
+    }
+};
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * ======================================================================================
+ * TOPIC: GROWABLE ARRAY STACK (no fixed 100-element cap)
+ * ======================================================================================
+ * 01_stack_using_array.c uses `int stack[100]` and a global top, so a push past the
+ * array silently fails. Stack<T> keeps the same push/pop/top model but:
+ *
+ * 1. Grows geometrically: capacity *= GROW_NUM / GROW_DEN (default 2/1) when full,
+ *    so n pushes cost O(n) moves in total.
+ * 2. Stores the first INLINE elements inside the object itself (small-buffer
+ *    optimisation): short-lived small stacks never touch the heap.
+ * 3. reserve(n) pre-sizes, shrink_to_fit() gives memory back (and returns to the
+ *    inline buffer when the stack fits).
+ * 4. Works with move-only types such as unique_ptr: elements are moved, never copied.
+ *
+ * main() benchmarks push/pop against std::stack over std::vector and std::deque.
+ *      Usage: ./a.out [operations]
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <stack>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <new>
+#include <utility>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+template <class T, size_t INLINE = 16, size_t GROW_NUM = 2, size_t GROW_DEN = 1>
+class Stack {
+    static_assert(INLINE > 0, "inline capacity must be at least 1");
+    static_assert(GROW_NUM > GROW_DEN, "growth factor must be greater than 1");
+
+public:
+    Stack() : data_(inline_ptr()), cap_(INLINE) {}
+
+    Stack(Stack&& other) noexcept : Stack() { steal(other); }
+
+    Stack& operator=(Stack&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release();
+            data_ = inline_ptr();
+            cap_ = INLINE;
+            steal(other);
+        }
+        return *this;
+    }
+
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+
+    ~Stack() {
+        clear();
+        release();
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return cap_; }
+    bool on_heap() const { return data_ != inline_ptr(); }
+
+    void push(const T& v) { emplace(v); }
+    void push(T&& v) { emplace(std::move(v)); }
+
+    // The new element is built before the old buffer is released, so
+    // arguments that refer into the stack (push(top())) stay valid.
+    template <class... Args>
+    T& emplace(Args&&... args) {
+        if (size_ < cap_) {
+            T* p = new (data_ + size_) T(std::forward<Args>(args)...);
+            size_++;
+            return *p;
+        }
+        size_t new_cap = grown(cap_);
+        T* fresh = allocate(new_cap);
+        T* p;
+        try {
+            p = new (fresh + size_) T(std::forward<Args>(args)...);
+        } catch (...) {
+            if (fresh != inline_ptr())
+                ::operator delete(fresh);
+            throw;
+        }
+        adopt(fresh, new_cap);
+        size_++;
+        return *p;
+    }
+
+    // top() and pop() assume the stack is non-empty.
+    T& top() { return data_[size_ - 1]; }
+    const T& top() const { return data_[size_ - 1]; }
+
+    void pop() {
+        size_--;
+        data_[size_].~T();
+    }
+
+    // Moves the top element out and removes it.
+    T take() {
+        T v = std::move(data_[size_ - 1]);
+        pop();
+        return v;
+    }
+
+    void clear() {
+        while (size_ > 0)
+            pop();
+    }
+
+    void reserve(size_t n) {
+        if (n > cap_)
+            reallocate(n);
+    }
+
+    void shrink_to_fit() {
+        if (!on_heap() || size_ == cap_)
+            return;
+        reallocate(size_ <= INLINE ? INLINE : size_);
+    }
+
+private:
+    alignas(T) unsigned char inline_buf_[INLINE * sizeof(T)];
+    T* data_;
+    size_t size_ = 0;
+    size_t cap_;
+
+    T* inline_ptr() { return reinterpret_cast<T*>(inline_buf_); }
+    const T* inline_ptr() const { return reinterpret_cast<const T*>(inline_buf_); }
+
+    static size_t grown(size_t cap) {
+        size_t next = cap * GROW_NUM / GROW_DEN;
+        return next > cap ? next : cap + 1;
+    }
+
+    // A buffer of new_cap elements: the inline one if new_cap == INLINE.
+    T* allocate(size_t new_cap) {
+        return new_cap == INLINE ? inline_ptr() : static_cast<T*>(::operator new(new_cap * sizeof(T)));
+    }
+
+    void reallocate(size_t new_cap) { adopt(allocate(new_cap), new_cap); }
+
+    // Moves the elements into fresh and releases the old buffer; trivially
+    // copyable elements go across with one memcpy.
+    void adopt(T* fresh, size_t new_cap) {
+        if (is_trivially_copyable<T>::value) {
+            if (size_ > 0)
+                memcpy((void*)fresh, (const void*)data_, size_ * sizeof(T));
+        } else {
+            for (size_t i = 0; i < size_; i++) {
+                new (fresh + i) T(std::move(data_[i]));
+                data_[i].~T();
+            }
+        }
+        release();
+        data_ = fresh;
+        cap_ = new_cap;
+    }
+
+    void release() {
+        if (on_heap())
+            ::operator delete(data_);
+    }
+
+    // Takes other's elements; other must be empty-handed afterwards.
+    void steal(Stack& other) {
+        if (other.on_heap()) {
+            data_ = other.data_;
+            cap_ = other.cap_;
+            size_ = other.size_;
+        } else {
+            for (size_t i = 0; i < other.size_; i++) {
+                new (data_ + i) T(std::move(other.data_[i]));
+                other.data_[i].~T();
+            }
+            size_ = other.size_;
+        }
+        other.data_ = other.inline_ptr();
+        other.cap_ = INLINE;
+        other.size_ = 0;
+    }
+};
+
+static double seconds_since(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// Pushes `depth` values and pops them again, `rounds` times.
+template <class S>
+static double bench(long depth, long rounds, long long& sum) {
+    auto t0 = chrono::steady_clock::now();
+    for (long r = 0; r < rounds; r++) {
+        S s;
+        for (long i = 0; i < depth; i++)
+            s.push((int)i);
+        while (!s.empty()) {
+            sum += s.top();
+            s.pop();
+        }
+    }
+    return seconds_since(t0);
+}
+
+int main(int argc, char* argv[]) {
+    long ops = argc > 1 ? atol(argv[1]) : 50000000;
+
+    Stack<unique_ptr<int>, 4> owners;           // move-only elements
+    for (int i = 0; i < 10; i++)
+        owners.push(make_unique<int>(i));
+    cout << "size " << owners.size() << ", capacity " << owners.capacity()
+         << ", on heap " << owners.on_heap() << endl;
+    while (owners.size() > 3)
+        owners.pop();
+    owners.shrink_to_fit();                     // back into the inline buffer
+    cout << "after shrink: size " << owners.size() << ", capacity " << owners.capacity()
+         << ", on heap " << owners.on_heap() << ", top " << *owners.top() << endl;
+
+    // push(top()) when full: the argument lives in the buffer being replaced
+    Stack<string, 2> words;
+    words.push(string(40, 'a'));
+    words.push(string(40, 'b'));
+    words.push(words.top());
+    words.push(words.top());
+    bool same = words.size() == 4 && words.top() == string(40, 'b') && words.capacity() == 4;
+    words.push(words.top());                    // inline -> heap and heap -> heap
+    cout << "push(top()) at capacity: " << (same && words.top() == string(40, 'b') ? "ok" : "WRONG") << endl;
+
+    // Shallow stacks (typical parser use) and one deep stack.
+    long depths[] = {8, 1000, ops};
+    for (long depth : depths) {
+        long rounds = ops / depth;
+        long long sum = 0;
+        double a = bench<Stack<int>>(depth, rounds, sum);
+        double b = bench<stack<int, vector<int>>>(depth, rounds, sum);
+        double c = bench<stack<int, deque<int>>>(depth, rounds, sum);
+        cout << "\ndepth " << depth << " x " << rounds << " rounds (checksum " << sum << ")\n";
+        cout << "Stack<int>:                 " << a << " s\n";
+        cout << "std::stack<vector<int>>:    " << b << " s\n";
+        cout << "std::stack<deque<int>>:     " << c << " s\n";
+    }
+    return 0;
+}
@@ -0,0 +1,298 @@
+/*
+ * ======================================================================================
+ * TOPIC: LINKED STACK WITH A PER-THREAD NODE CACHE (magazines + depot)
+ * ======================================================================================
+ * In 02_stack_using_ll.c every push() calls malloc and every pop() calls free. For a
+ * stack that grows and shrinks all the time those calls are most of the work.
+ *
+ * NodeCache<SIZE> keeps freed nodes for reuse, in three layers (Bonwick's magazines):
+ *
+ * 1. Thread layer: each thread holds two "magazines" (arrays of up to M free nodes).
+ *    allocate()/release() pop/push a magazine with no locks and no atomics.
+ * 2. Depot: when both magazines are empty (or both full) the thread swaps a whole
+ *    magazine with a global depot under a mutex, i.e. once per M operations at most.
+ * 3. Global allocator: only when the depot has nothing, a slab of M nodes is taken
+ *    from operator new. Slabs are kept for the life of the program.
+ *
+ * Holding two magazines means a stack bouncing around a magazine boundary swaps the
+ * two locally instead of going to the depot on every operation.
+ *
+ * Once a program's peak stack depth has been reached, push/pop never call the global
+ * allocator again. stats() reports how often each layer was used.
+ *      Build: g++ -O2 -pthread 05_cached_node_stack.cpp
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <cstdint>
+
+using namespace std;
+
+struct NodeCacheStats {
+    uint64_t global_allocs;     // calls into operator new (slabs and magazines)
+    uint64_t depot_swaps;       // magazines exchanged with the depot
+    uint64_t local_ops;         // allocate/release served from the thread's magazines
+};
+
+template <size_t SIZE, size_t M = 64>
+class NodeCache {
+public:
+    static void* allocate() {
+        ThreadCache& tc = local();
+        if (tc.loaded->count == 0) {
+            if (tc.previous->count > 0)
+                swap(tc.loaded, tc.previous);
+            else
+                refill(tc);
+        }
+        tc.ops++;
+        return tc.loaded->rounds[--tc.loaded->count];
+    }
+
+    static void release(void* p) {
+        ThreadCache& tc = local();
+        if (tc.loaded->count == M) {
+            if (tc.previous->count == 0)
+                swap(tc.loaded, tc.previous);
+            else
+                spill(tc);
+        }
+        tc.ops++;
+        tc.loaded->rounds[tc.loaded->count++] = p;
+    }
+
+    static NodeCacheStats stats() {
+        Depot& d = depot();
+        NodeCacheStats s;
+        s.global_allocs = d.global_allocs.load();
+        s.depot_swaps = d.swaps.load();
+        s.local_ops = d.retired_ops.load() + local().ops;
+        return s;
+    }
+
+private:
+    struct Magazine {
+        size_t count = 0;
+        void* rounds[M];
+    };
+
+    struct Depot {
+        mutex m;
+        vector<Magazine*> full;
+        vector<Magazine*> empty;
+        vector<unsigned char*> slabs;
+        atomic<uint64_t> global_allocs{0};
+        atomic<uint64_t> swaps{0};
+        atomic<uint64_t> retired_ops{0};    // ops of threads that have exited
+
+        Magazine* new_magazine() {
+            global_allocs++;
+            return new Magazine;
+        }
+
+        ~Depot() {
+            for (Magazine* g : full)
+                delete g;
+            for (Magazine* g : empty)
+                delete g;
+            for (unsigned char* s : slabs)
+                ::operator delete(s);
+        }
+    };
+
+    struct ThreadCache {
+        Magazine* loaded;
+        Magazine* previous;
+        uint64_t ops = 0;
+
+        ThreadCache() {
+            Depot& d = depot();
+            lock_guard<mutex> lock(d.m);
+            loaded = take_empty(d);
+            previous = take_empty(d);
+        }
+
+        // A thread's cached nodes go back to the depot when it exits.
+        ~ThreadCache() {
+            Depot& d = depot();
+            lock_guard<mutex> lock(d.m);
+            for (Magazine* g : {loaded, previous})
+                (g->count > 0 ? d.full : d.empty).push_back(g);
+            d.retired_ops += ops;
+        }
+    };
+
+    static Depot& depot() {
+        static Depot d;
+        return d;
+    }
+
+    static ThreadCache& local() {
+        thread_local ThreadCache tc;
+        return tc;
+    }
+
+    static Magazine* take_empty(Depot& d) {
+        if (d.empty.empty())
+            return d.new_magazine();
+        Magazine* g = d.empty.back();
+        d.empty.pop_back();
+        return g;
+    }
+
+    // Both magazines are empty: trade one for a full magazine, or carve a slab.
+    static void refill(ThreadCache& tc) {
+        Depot& d = depot();
+        lock_guard<mutex> lock(d.m);
+        if (!d.full.empty()) {
+            d.empty.push_back(tc.previous);
+            tc.previous = tc.loaded;
+            tc.loaded = d.full.back();
+            d.full.pop_back();
+            d.swaps++;
+            return;
+        }
+        size_t stride = (SIZE + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t);
+        unsigned char* slab = static_cast<unsigned char*>(::operator new(stride * M));
+        d.slabs.push_back(slab);
+        d.global_allocs++;
+        for (size_t i = 0; i < M; i++)
+            tc.loaded->rounds[i] = slab + i * stride;
+        tc.loaded->count = M;
+    }
+
+    // Both magazines are full: hand one to the depot and continue with an empty one.
+    static void spill(ThreadCache& tc) {
+        Depot& d = depot();
+        lock_guard<mutex> lock(d.m);
+        d.full.push_back(tc.previous);
+        tc.previous = tc.loaded;
+        tc.loaded = take_empty(d);
+        d.swaps++;
+    }
+};
+
+// The linked stack of 02_stack_using_ll.c with nodes from NodeCache.
+class LinkedStack {
+public:
+    ~LinkedStack() {
+        int v;
+        while (pop(v)) {
+        }
+    }
+
+    void push(int val) {
+        node* ptr = new (Cache::allocate()) node;
+        ptr->val = val;
+        ptr->next = head;
+        head = ptr;
+    }
+
+    bool pop(int& item) {
+        if (head == nullptr)
+            return false;
+        node* ptr = head;
+        item = ptr->val;
+        head = ptr->next;
+        Cache::release(ptr);
+        return true;
+    }
+
+    static NodeCacheStats stats() { return Cache::stats(); }
+
+private:
+    struct node {
+        int val;
+        node* next;
+    };
+    typedef NodeCache<sizeof(node)> Cache;
+
+    node* head = nullptr;
+};
+
+// Same stack on malloc/free, as in the C program.
+class MallocStack {
+    struct node {
+        int val;
+        node* next;
+    };
+    node* head = nullptr;
+
+public:
+    ~MallocStack() {
+        int v;
+        while (pop(v)) {
+        }
+    }
+
+    void push(int val) {
+        node* ptr = (node*)malloc(sizeof(node));
+        ptr->val = val;
+        ptr->next = head;
+        head = ptr;
+    }
+
+    bool pop(int& item) {
+        if (head == nullptr)
+            return false;
+        node* ptr = head;
+        item = ptr->val;
+        head = ptr->next;
+        free(ptr);
+        return true;
+    }
+};
+
+// Parser-like workload: bursts of pushes and pops of varying depth.
+template <class S>
+static double workload(long rounds, long long& sum) {
+    auto t0 = chrono::steady_clock::now();
+    S s;
+    int v = 0;
+    for (long r = 0; r < rounds; r++) {
+        int depth = 1 + (int)(r * 7919 % 200);
+        for (int i = 0; i < depth; i++)
+            s.push(i);
+        for (int i = 0; i < depth; i++) {
+            if (!s.pop(v))
+                break;
+            sum += v;
+        }
+    }
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+static void print_stats(const char* label) {
+    NodeCacheStats s = LinkedStack::stats();
+    cout << label << ": global allocator calls " << s.global_allocs << ", depot swaps "
+         << s.depot_swaps << ", local ops " << s.local_ops << endl;
+}
+
+int main() {
+    long long sum = 0;
+    workload<LinkedStack>(1000, sum);
+    print_stats("after warm-up      ");
+    double cached = workload<LinkedStack>(200000, sum);
+    print_stats("after 200000 rounds");
+    double plain = workload<MallocStack>(200000, sum);
+    cout << "node cache: " << cached << " s, malloc/free: " << plain << " s\n\n";
+
+    // Nodes freed by exiting threads go back to the depot and are reused.
+    vector<thread> pool;
+    for (int t = 0; t < 4; t++)
+        pool.emplace_back([]() {
+            long long s = 0;
+            workload<LinkedStack>(50000, s);
+        });
+    for (auto& th : pool)
+        th.join();
+    print_stats("after 4 threads    ");
+    return 0;
+}
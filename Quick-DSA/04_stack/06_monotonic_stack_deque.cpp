@@ -0,0 +1,216 @@
+/*
+ * ======================================================================================
+ * TOPIC: MONOTONIC STACK AND MONOTONIC DEQUE
+ * ======================================================================================
+ * A monotonic stack is the array stack of 01_stack_using_array.c with one rule: before
+ * pushing x, pop everything that x "beats". The stack then stays sorted, and each pop
+ * answers a question about the popped element:
+ *
+ *      next greater element   popped elements have found their next greater (x)
+ *      stock span             after popping smaller prices, the top is the previous
+ *                             greater price, so span = i - top.index
+ *
+ * A monotonic deque does the same at the back and also drops the front when it falls
+ * out of a sliding window, so its front is always the window max (or min).
+ *
+ * Every element is pushed and popped at most once: amortised O(1) per element. Both
+ * containers keep (value, index) pairs in contiguous storage: a reserved vector for the
+ * stack and a power-of-two ring for the deque, which is sized once from the window.
+ *
+ * Batch functions work on int arrays; the stream classes take one element at a time
+ * so inputs larger than memory can be processed in chunks.
+ *
+ * main() streams N generated prices (default 10^9) through the span and window
+ * max/min engines and reports throughput.
+ *      Usage: ./a.out [N] [window]
+ * ======================================================================================
+ */
+
+#include <iostream>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+struct Entry {
+    int value;
+    int64_t index;
+};
+
+// Pushing x first pops every top for which Beats(x, top) holds. With
+// Beats = greater_equal<int> the stack is strictly decreasing from bottom to top.
+template <class Beats>
+class MonotonicStack {
+public:
+    explicit MonotonicStack(size_t reserve = 1024) { s.reserve(reserve); }
+
+    // Pops everything v beats, calling popped(entry) for each, then pushes v.
+    template <class F>
+    void push(int v, int64_t index, F popped) {
+        while (!s.empty() && beats(v, s.back().value)) {
+            popped(s.back());
+            s.pop_back();
+        }
+        s.push_back(Entry{v, index});
+    }
+
+    void push(int v, int64_t index) {
+        push(v, index, [](const Entry&) {});
+    }
+
+    bool empty() const { return s.empty(); }
+    const Entry& top() const { return s.back(); }
+    // Entry just below the top (requires size() >= 2).
+    const Entry& below_top() const { return s[s.size() - 2]; }
+    size_t size() const { return s.size(); }
+    void clear() { s.clear(); }
+
+private:
+    vector<Entry> s;
+    Beats beats;
+};
+
+// Sliding-window extreme over the last `window` indices. Better(a, b) says a should
+// replace b as the answer: greater<int> for max, less<int> for min.
+// A window below 1 is rejected: valid() is false and push() must not be called.
+template <class Better>
+class MonotonicDeque {
+public:
+    explicit MonotonicDeque(int64_t window) : w(window) {
+        if (window < 1)
+            return;
+        size_t cap = 1;
+        while (cap < (size_t)window + 1)
+            cap <<= 1;
+        buf.resize(cap);
+        mask = cap - 1;
+    }
+
+    bool valid() const { return w >= 1; }
+
+    // Adds element `index` (indices must increase by 1) and returns the extreme of
+    // the window ending at it.
+    int push(int v, int64_t index) {
+        while (tail != head && !better(buf[(tail - 1) & mask].value, v))
+            tail--;
+        buf[tail & mask] = Entry{v, index};
+        tail++;
+        if (buf[head & mask].index <= index - w)
+            head++;
+        return buf[head & mask].value;
+    }
+
+private:
+    vector<Entry> buf;
+    size_t mask = 0;
+    size_t head = 0, tail = 0;      // live entries are [head, tail)
+    int64_t w;
+    Better better;
+};
+
+// ---------------------------------------------------------------------------
+// Batch APIs over int arrays
+// ---------------------------------------------------------------------------
+
+// out[i] = first a[j] > a[i] with j > i, or -1.
+void next_greater(const int* a, size_t n, int* out) {
+    for (size_t i = 0; i < n; i++)
+        out[i] = -1;
+    // equal values do not pop each other: "greater" is strict
+    MonotonicStack<greater<int>> s(64);
+    for (size_t i = 0; i < n; i++)
+        s.push(a[i], (int64_t)i, [&](const Entry& e) { out[e.index] = a[i]; });
+}
+
+// out[i] = number of consecutive days up to i with price <= a[i].
+void stock_span(const int* a, size_t n, int* out) {
+    MonotonicStack<greater_equal<int>> s(64);
+    for (size_t i = 0; i < n; i++) {
+        s.push(a[i], (int64_t)i);
+        out[i] = s.size() >= 2 ? (int)(i - s.below_top().index) : (int)(i + 1);
+    }
+}
+
+// out[i] = max of a[i-w+1 .. i] (partial window at the start). Returns false and
+// leaves out untouched when w < 1.
+bool sliding_max(const int* a, size_t n, int64_t w, int* out) {
+    MonotonicDeque<greater<int>> d(w);
+    if (!d.valid())
+        return false;
+    for (size_t i = 0; i < n; i++)
+        out[i] = d.push(a[i], (int64_t)i);
+    return true;
+}
+
+bool sliding_min(const int* a, size_t n, int64_t w, int* out) {
+    MonotonicDeque<less<int>> d(w);
+    if (!d.valid())
+        return false;
+    for (size_t i = 0; i < n; i++)
+        out[i] = d.push(a[i], (int64_t)i);
+    return true;
+}
+
+static void print(const char* label, const int* a, size_t n) {
+    cout << label;
+    for (size_t i = 0; i < n; i++)
+        cout << a[i] << " ";
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int64_t n = argc > 1 ? atoll(argv[1]) : 1000000000LL;
+    int64_t w = argc > 2 ? atoll(argv[2]) : 1000;
+    if (w < 1) {
+        cerr << "window must be at least 1" << endl;
+        return 1;
+    }
+
+    int prices[] = {100, 80, 60, 70, 60, 75, 85};
+    const size_t k = sizeof(prices) / sizeof(prices[0]);
+    int out[k];
+    print("prices:        ", prices, k);
+    next_greater(prices, k, out);
+    print("next greater:  ", out, k);       // -1 85 70 75 75 85 -1
+    stock_span(prices, k, out);
+    print("stock span:    ", out, k);       // 1 1 1 2 1 4 6
+    sliding_max(prices, k, 3, out);
+    print("window-3 max:  ", out, k);       // 100 100 100 80 70 75 85
+    sliding_min(prices, k, 3, out);
+    print("window-3 min:  ", out, k);       // 100 80 60 60 60 60 60
+    cout << "window 0/-1:   " << (sliding_max(prices, k, 0, out) ? "accepted" : "rejected")
+         << " " << (sliding_min(prices, k, -1, out) ? "accepted" : "rejected") << endl;
+
+    // Stream n pseudo-random prices in chunks; nothing of size n is stored.
+    const size_t CHUNK = 1 << 16;
+    vector<int> chunk(CHUNK);
+    MonotonicStack<greater_equal<int>> span(1024);
+    MonotonicDeque<greater<int>> wmax(w);
+    MonotonicDeque<less<int>> wmin(w);
+    uint32_t x = 12345;
+    int64_t checksum = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (int64_t base = 0; base < n; base += CHUNK) {
+        size_t len = (size_t)min<int64_t>(CHUNK, n - base);
+        for (size_t i = 0; i < len; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            chunk[i] = (int)(x % 100000);
+        }
+        for (size_t i = 0; i < len; i++) {
+            int64_t idx = base + (int64_t)i;
+            span.push(chunk[i], idx);
+            int64_t s = span.size() >= 2 ? idx - span.below_top().index : idx + 1;
+            checksum += s + wmax.push(chunk[i], idx) - wmin.push(chunk[i], idx);
+        }
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cout << "\nN = " << n << ", window " << w << ": " << secs << " s, "
+         << n / secs / 1e6 << " M elements/s (span + window max + window min, checksum "
+         << checksum << ")" << endl;
+    return 0;
+}